@@ -0,0 +1,591 @@
+#include "code_gen.hpp"
+#include "profile.hpp"
+#include <string.h>
+
+#define THREAD_HOPS 32 // Max jumps followed when threading one branch.
+
+/* ==================================================
+   CFG PASS OVER THE BUFFERED TM CODE
+   ================================================== */
+// Works on the final instruction at every address (the last line emitted for
+// it, so backpatches win). All code references in generated TM are relative
+// to the PC (base register 7), which lets instructions be deleted and the
+// survivors relocated.
+
+struct CFG
+{
+   vector<TMLine> *lines;
+   vector<int> at;     // address -> index of its line in lines (-1 if never emitted)
+   vector<bool> dead;  // address deleted
+   vector<int> refs;   // number of PC-relative references to the address
+   vector<bool> fixed; // jump table entry: may be retargeted, never deleted
+   int size;
+};
+
+static TMLine *instr(CFG &cfg, int addr)
+{
+   if (addr < 0 || addr >= cfg.size || cfg.at[addr] < 0)
+      return NULL;
+   return &(*cfg.lines)[cfg.at[addr]];
+}
+
+// First live address at or after addr.
+static int live(CFG &cfg, int addr)
+{
+   while (addr < cfg.size && addr >= 0 && cfg.dead[addr])
+      addr++;
+   return addr;
+}
+
+// Does the instruction hold a PC-relative reference (r,d(7))?
+static bool is_pc_ref(TMLine *in)
+{
+   return in != NULL && !in->isRO && in->s == PC;
+}
+
+static bool is_cond_jump(TMLine *in)
+{
+   return is_pc_ref(in) && (in->op == "JNZ" || in->op == "JZR");
+}
+
+static bool is_jump(TMLine *in)
+{
+   return is_pc_ref(in) && (in->op == "JMP" || in->op == "JNZ" || in->op == "JZR" || (in->op == "LDA" && in->r == PC));
+}
+
+static bool is_uncond_jump(TMLine *in)
+{
+   return is_jump(in) && !is_cond_jump(in);
+}
+
+// Does control never fall through to the next address?
+static bool ends_block(TMLine *in)
+{
+   if (in == NULL || in->op == "HALT")
+      return true;
+   if (in->isRO)
+      return false;
+   if (in->op == "JMP")
+      return !is_cond_jump(in);
+   return (in->op == "LDA" || in->op == "LD" || in->op == "LDC") && in->r == PC;
+}
+
+static int target(int addr, TMLine *in)
+{
+   return addr + 1 + (int)in->d;
+}
+
+// Number of JMP entries after the "ADD 7,3,7" of a jump table, read from the
+// "LDC 4,n(6)" "SWP 3,4,4" clamp in front of it (see generate_jump_table);
+// 0 if addr is no table dispatch.
+static int table_size(CFG &cfg, int addr)
+{
+   TMLine *in = instr(cfg, addr);
+   TMLine *swp = instr(cfg, addr - 1);
+   TMLine *ldc = instr(cfg, addr - 2);
+   if (in == NULL || !in->isRO || in->op != "ADD" || in->r != PC || in->d != AC || in->s != PC)
+      return 0;
+   if (swp == NULL || !swp->isRO || swp->op != "SWP" || swp->r != AC || swp->d != AC1)
+      return 0;
+   if (ldc == NULL || ldc->isRO || ldc->op != "LDC" || ldc->r != AC1 || ldc->d < 1)
+      return 0;
+   return (int)ldc->d + 1;
+}
+
+static void count_refs(CFG &cfg)
+{
+   cfg.refs.assign(cfg.size + 1, 0);
+   for (int a = 0; a < cfg.size; a++)
+   {
+      TMLine *in = instr(cfg, a);
+      if (!cfg.dead[a] && is_pc_ref(in))
+      {
+         int t = live(cfg, target(a, in));
+         if (t >= 0 && t <= cfg.size)
+            cfg.refs[t]++;
+      }
+   }
+}
+
+// Follows jump chains from the branch at addr. A conditional branch also
+// knows its register on the taken edge (zero for JZR, nonzero for JNZ), so a
+// later test of the same register on that path is decided statically.
+static int thread_jumps(CFG &cfg)
+{
+   int changes = 0;
+   for (int a = 0; a < cfg.size; a++)
+   {
+      TMLine *in = instr(cfg, a);
+      if (cfg.dead[a] || !is_jump(in))
+         continue;
+      bool known = is_cond_jump(in);
+      int reg = (int)in->r;
+      bool zero = in->op == "JZR";
+      int t = live(cfg, target(a, in));
+      for (int hop = 0; hop < THREAD_HOPS; hop++)
+      {
+         TMLine *next = instr(cfg, t);
+         if (next == NULL || t == a)
+            break;
+         if (is_uncond_jump(next))
+            t = live(cfg, target(t, next));
+         else if (known && is_cond_jump(next) && next->r == reg)
+            t = live(cfg, (next->op == "JZR") == zero ? target(t, next) : t + 1);
+         else
+            break;
+      }
+      if (t != live(cfg, target(a, in)))
+      {
+         in->d = t - a - 1;
+         changes++;
+      }
+   }
+   return changes;
+}
+
+// "JNZ r,1(7)" over a "JMP L" nothing else reaches becomes "JZR r,L" (and
+// the other way round); the JMP is deleted.
+static int fold_branch_over_jump(CFG &cfg)
+{
+   int changes = 0;
+   count_refs(cfg);
+   for (int a = 0; a < cfg.size; a++)
+   {
+      TMLine *in = instr(cfg, a);
+      if (cfg.dead[a] || !is_cond_jump(in))
+         continue;
+      int j = live(cfg, a + 1);
+      TMLine *jmp = instr(cfg, j);
+      if (live(cfg, target(a, in)) != live(cfg, j + 1) || !is_uncond_jump(jmp) || cfg.refs[j] != 0 || cfg.fixed[j])
+         continue;
+      int t = live(cfg, target(j, jmp));
+      if (t == j)
+         continue;
+      in->op = in->op == "JNZ" ? "JZR" : "JNZ";
+      in->d = t - a - 1;
+      in->text = jmp->text;
+      cfg.dead[j] = true;
+      changes++;
+   }
+   return changes;
+}
+
+// Deletes jumps to the next live address (empty blocks) and code that
+// cannot be reached from address 0 or from a return address (LDA r,d(7)).
+static int delete_empty_and_unreachable(CFG &cfg)
+{
+   int changes = 0;
+   for (int a = 0; a < cfg.size; a++)
+   {
+      TMLine *in = instr(cfg, a);
+      if (!cfg.dead[a] && !cfg.fixed[a] && is_jump(in) && live(cfg, target(a, in)) == live(cfg, a + 1))
+      {
+         cfg.dead[a] = true;
+         changes++;
+      }
+   }
+
+   vector<bool> reached(cfg.size, false);
+   vector<int> work;
+   work.push_back(live(cfg, 0));
+   for (int a = 0; a < cfg.size; a++)
+   {
+      TMLine *in = instr(cfg, a);
+      if (!cfg.dead[a] && is_pc_ref(in) && !is_jump(in))
+         work.push_back(live(cfg, target(a, in)));
+   }
+   while (!work.empty())
+   {
+      int a = work.back();
+      work.pop_back();
+      if (a < 0 || a >= cfg.size || reached[a])
+         continue;
+      reached[a] = true;
+      TMLine *in = instr(cfg, a);
+      if (is_jump(in))
+         work.push_back(live(cfg, target(a, in)));
+      for (int k = table_size(cfg, a); k > 0; k--)
+         work.push_back(a + k);
+      if (!ends_block(in))
+         work.push_back(live(cfg, a + 1));
+   }
+   for (int a = 0; a < cfg.size; a++)
+   {
+      if (!cfg.dead[a] && !reached[a] && cfg.at[a] >= 0)
+      {
+         cfg.dead[a] = true;
+         changes++;
+      }
+   }
+   return changes;
+}
+
+// Renumbers the live instructions and rewrites every PC-relative offset.
+static void relocate(CFG &cfg)
+{
+   vector<int> newLoc(cfg.size + 1, 0);
+   int n = 0;
+   for (int a = 0; a < cfg.size; a++)
+   {
+      newLoc[a] = n;
+      if (!cfg.dead[a])
+         n++;
+   }
+   newLoc[cfg.size] = n;
+   relocate_profile_sites(newLoc);
+   for (int a = 0; a < cfg.size; a++)
+   {
+      TMLine *in = instr(cfg, a);
+      if (cfg.dead[a] || in == NULL)
+         continue;
+      if (is_pc_ref(in))
+         in->d = newLoc[live(cfg, target(a, in))] - newLoc[a] - 1;
+   }
+   vector<TMLine> out;
+   for (size_t i = 0; i < cfg.lines->size(); i++)
+   {
+      TMLine &line = (*cfg.lines)[i];
+      if (line.isInstr)
+      {
+         if (cfg.at[line.loc] != (int)i || cfg.dead[line.loc])
+            continue;
+         line.loc = newLoc[line.loc];
+      }
+      out.push_back(line);
+   }
+   // Addresses reserved but never written hold HALT; keep them explicit.
+   for (int a = 0; a < cfg.size; a++)
+   {
+      if (cfg.at[a] < 0 && !cfg.dead[a])
+      {
+         TMLine halt;
+         halt.isInstr = true;
+         halt.loc = newLoc[a];
+         halt.isRO = true;
+         halt.op = "HALT";
+         halt.r = halt.d = halt.s = 0;
+         halt.text = "Unused location ";
+         halt.lineNum = 0;
+         halt.func = NULL;
+         out.push_back(halt);
+      }
+   }
+   *cfg.lines = out;
+}
+
+static void build_cfg(CFG &cfg, vector<TMLine> &lines)
+{
+   cfg.lines = &lines;
+   cfg.size = 0;
+   for (size_t i = 0; i < lines.size(); i++)
+      if (lines[i].isInstr && lines[i].loc >= cfg.size)
+         cfg.size = lines[i].loc + 1;
+   cfg.at.assign(cfg.size, -1);
+   cfg.dead.assign(cfg.size, false);
+   for (size_t i = 0; i < lines.size(); i++)
+      if (lines[i].isInstr)
+         cfg.at[lines[i].loc] = i;
+   cfg.fixed.assign(cfg.size, false);
+   for (int a = 0; a < cfg.size; a++)
+      for (int k = table_size(cfg, a); k > 0; k--)
+         if (a + k < cfg.size)
+            cfg.fixed[a + k] = true;
+}
+
+/* ==================================================
+   OPTIMIZE CFG
+   ================================================== */
+// Jump threading, branch threading on known conditions and empty/unreachable
+// block deletion. Returns the number of rewrites.
+int optimize_cfg(vector<TMLine> &lines)
+{
+   CFG cfg;
+   build_cfg(cfg, lines);
+
+   int total = 0;
+   for (int round = 0; round < 8; round++)
+   {
+      int changes = thread_jumps(cfg);
+      changes += fold_branch_over_jump(cfg);
+      changes += delete_empty_and_unreachable(cfg);
+      total += changes;
+      if (changes == 0)
+         break;
+   }
+   relocate(cfg);
+   return total;
+}
+
+/* ==================================================
+   DEAD STORES AND COPY PROPAGATION
+   ================================================== */
+// Works on the frame slots d(FP) of the running function. Calls, memory
+// accessed through a computed address (arrays, MOV/SET/CO) and changes of
+// FP may touch any slot, so they read every slot and forget what registers
+// hold. "LD 1,0(1)" leaves the frame: none of its slots is read after it.
+// - Copy propagation: a load of a slot into a register that holds its value
+//   on every path (it was stored from or loaded into it) is deleted.
+// - Dead store elimination: a store to a slot no path reads before the slot
+//   is stored again or the frame is left is deleted.
+
+struct Slots
+{
+   CFG *cfg;
+   map<int, int> index;             // frame offset -> slot number
+   int count;
+   vector<vector<bool> > liveIn;    // per address: slots read later
+   vector<vector<unsigned char> > held; // per address on entry: registers holding each slot
+};
+
+static bool is_frame_mem(TMLine *in)
+{
+   return in != NULL && !in->isRO && in->s == FP && (in->op == "LD" || in->op == "ST") && in->r != FP && in->r != PC;
+}
+
+static bool is_frame_exit(TMLine *in)
+{
+   return in != NULL && !in->isRO && in->op == "LD" && in->r == FP && in->s == FP && in->d == 0;
+}
+
+// A call is "LDA 3,1(7)" followed by "JMP 7,d(7)"; it returns to the next address.
+static bool is_call(CFG &cfg, int addr)
+{
+   TMLine *in = instr(cfg, addr);
+   TMLine *prev = instr(cfg, addr - 1);
+   return is_uncond_jump(in) && in->op == "JMP" && prev != NULL && !prev->isRO && prev->op == "LDA" &&
+          prev->r == AC && prev->d == 1 && prev->s == PC;
+}
+
+// Registers the instruction writes (the PC only for unconditional jumps).
+static int reg_defs(TMLine *in)
+{
+   if (in == NULL)
+      return 0;
+   if (in->isRO)
+   {
+      if (in->op == "HALT" || in->op == "NOP" || in->op == "OUT" || in->op == "OUTB" || in->op == "OUTC" ||
+          in->op == "OUTNL" || in->op == "MOV" || in->op == "SET")
+         return 0;
+      if (in->op == "SWP" || in->op == "CO" || in->op == "COA")
+         return (1 << in->r) | (1 << in->d);
+      return 1 << in->r;
+   }
+   if (in->op == "ST" || in->op == "JNZ" || in->op == "JZR")
+      return 0;
+   if (in->op == "JMP")
+      return 1 << PC;
+   return 1 << in->r;
+}
+
+static bool is_indirect(TMLine *in, const char *op)
+{
+   return !in->isRO && in->op == op && in->s != FP && in->s != GP && in->s != PC;
+}
+
+// May read any slot.
+static bool reads_all(CFG &cfg, int addr)
+{
+   TMLine *in = instr(cfg, addr);
+   if (in == NULL || is_frame_exit(in))
+      return false;
+   if (is_call(cfg, addr) || (reg_defs(in) & (1 << FP)) || is_indirect(in, "LD"))
+      return true;
+   return in->isRO && (in->op == "MOV" || in->op == "CO" || in->op == "COA");
+}
+
+// May write any slot, or changes what FP(-relative) means.
+static bool clobbers_all(CFG &cfg, int addr)
+{
+   TMLine *in = instr(cfg, addr);
+   if (in == NULL)
+      return false;
+   if (is_call(cfg, addr) || (reg_defs(in) & (1 << FP)) || is_indirect(in, "ST"))
+      return true;
+   return in->isRO && (in->op == "MOV" || in->op == "SET");
+}
+
+// Successors of addr; false if control goes somewhere unknown (computed jumps
+// other than jump tables).
+static bool successors(CFG &cfg, int addr, vector<int> &succ)
+{
+   succ.clear();
+   TMLine *in = instr(cfg, addr);
+   if (in == NULL || (in->isRO && in->op == "HALT"))
+      return true;
+   if (is_call(cfg, addr))
+   {
+      succ.push_back(addr + 1);
+      return true;
+   }
+   if (is_jump(in))
+   {
+      succ.push_back(target(addr, in));
+      if (is_cond_jump(in))
+         succ.push_back(addr + 1);
+      return true;
+   }
+   if (int n = table_size(cfg, addr))
+   {
+      for (int k = 1; k <= n; k++)
+         succ.push_back(addr + k);
+      return true;
+   }
+   if (reg_defs(in) & (1 << PC))
+      return false;
+   succ.push_back(addr + 1);
+   return true;
+}
+
+static void compute_liveness(Slots &sl)
+{
+   CFG &cfg = *sl.cfg;
+   vector<bool> all(sl.count, true), none(sl.count, false);
+   sl.liveIn.assign(cfg.size + 1, none);
+   vector<int> succ;
+   bool changed = true;
+   while (changed)
+   {
+      changed = false;
+      for (int a = cfg.size - 1; a >= 0; a--)
+      {
+         TMLine *in = instr(cfg, a);
+         vector<bool> live = none;
+         if (!successors(cfg, a, succ))
+            live = all;
+         for (size_t k = 0; k < succ.size(); k++)
+            if (succ[k] >= 0 && succ[k] <= cfg.size)
+               for (int s = 0; s < sl.count; s++)
+                  if (sl.liveIn[succ[k]][s])
+                     live[s] = true;
+         if (!cfg.dead[a])
+         {
+            if (is_frame_exit(in))
+            {
+               live = none;
+               if (sl.index.count(0))
+                  live[sl.index[0]] = true;
+            }
+            else if (reads_all(cfg, a))
+               live = all;
+            else if (is_frame_mem(in) && in->op == "LD")
+               live[sl.index[in->d]] = true;
+            else if (is_frame_mem(in))
+               live[sl.index[in->d]] = false;
+         }
+         if (live != sl.liveIn[a])
+         {
+            sl.liveIn[a] = live;
+            changed = true;
+         }
+      }
+   }
+}
+
+static void compute_held(Slots &sl)
+{
+   CFG &cfg = *sl.cfg;
+   vector<unsigned char> top(sl.count, 0xFF), empty(sl.count, 0);
+   vector<vector<unsigned char> > out(cfg.size + 1, top);
+   vector<vector<int> > preds(cfg.size + 1);
+   vector<bool> entry(cfg.size + 1, false);
+   vector<int> succ;
+   entry[0] = true;
+   for (int a = 0; a < cfg.size; a++)
+   {
+      successors(cfg, a, succ);
+      for (size_t k = 0; k < succ.size(); k++)
+         if (succ[k] >= 0 && succ[k] <= cfg.size)
+            preds[succ[k]].push_back(a);
+      if (is_call(cfg, a))
+      {
+         int t = target(a, instr(cfg, a));
+         if (t >= 0 && t <= cfg.size)
+            entry[t] = true;
+      }
+   }
+   sl.held.assign(cfg.size + 1, empty);
+   bool changed = true;
+   while (changed)
+   {
+      changed = false;
+      for (int a = 0; a < cfg.size; a++)
+      {
+         vector<unsigned char> h = empty;
+         if (!entry[a] && !preds[a].empty())
+         {
+            h = top;
+            for (size_t p = 0; p < preds[a].size(); p++)
+               for (int s = 0; s < sl.count; s++)
+                  h[s] &= out[preds[a][p]][s];
+         }
+         sl.held[a] = h;
+         TMLine *in = instr(cfg, a);
+         if (clobbers_all(cfg, a))
+            h = empty;
+         else
+         {
+            int defs = reg_defs(in);
+            for (int s = 0; s < sl.count; s++)
+               h[s] &= ~defs;
+            if (is_frame_mem(in) && in->op == "LD")
+               h[sl.index[in->d]] |= 1 << in->r;
+            else if (is_frame_mem(in))
+               h[sl.index[in->d]] = 1 << in->r;
+         }
+         if (h != out[a])
+         {
+            out[a] = h;
+            changed = true;
+         }
+      }
+   }
+}
+
+// Returns the number of loads and stores deleted.
+int optimize_stores(vector<TMLine> &lines)
+{
+   CFG cfg;
+   build_cfg(cfg, lines);
+   Slots sl;
+   sl.cfg = &cfg;
+   sl.count = 0;
+   for (int a = 0; a < cfg.size; a++)
+   {
+      TMLine *in = instr(cfg, a);
+      if (is_frame_mem(in) && sl.index.find(in->d) == sl.index.end())
+         sl.index[in->d] = sl.count++;
+   }
+   if (sl.index.find(0) == sl.index.end())
+      sl.index[0] = sl.count++;
+
+   int changes = 0;
+   compute_held(sl);
+   for (int a = 0; a < cfg.size; a++)
+   {
+      TMLine *in = instr(cfg, a);
+      if (is_frame_mem(in) && in->op == "LD" && (sl.held[a][sl.index[in->d]] & (1 << in->r)))
+      {
+         cfg.dead[a] = true;
+         changes++;
+      }
+   }
+   compute_liveness(sl);
+   vector<int> succ;
+   for (int a = 0; a < cfg.size; a++)
+   {
+      TMLine *in = instr(cfg, a);
+      if (!is_frame_mem(in) || in->op != "ST" || !successors(cfg, a, succ))
+         continue;
+      bool read = false;
+      for (size_t k = 0; k < succ.size(); k++)
+         if (succ[k] >= 0 && succ[k] <= cfg.size && sl.liveIn[succ[k]][sl.index[in->d]])
+            read = true;
+      if (!read)
+      {
+         cfg.dead[a] = true;
+         changes++;
+      }
+   }
+   relocate(cfg);
+   return changes;
+}
@@ -0,0 +1,935 @@
+#include "code_gen.hpp"
+#include "optimize.hpp"
+#include "pass_manager.hpp"
+#include "profile.hpp"
+#include <limits.h>
+#include <string.h>
+#include <algorithm>
+#include <map>
+#include <set>
+
+#define UNROLL_FULL_TRIPS 16 // Loops with at most this many trips are fully unrolled.
+#define UNROLL_BUDGET 512    // Max number of AST nodes emitted for the unrolled body copies.
+
+extern SymbolTable gcST;
+extern int toffset;
+extern int unroll_factor;
+extern int rotate_flag;
+extern int regloop_flag;
+extern int inline_io_flag;
+
+/* ==================================================
+   LOOP BODY HELPERS
+   ================================================== */
+// Number of nodes in the subtree (siblings included).
+int count_nodes(Node *node)
+{
+   int n = 0;
+   for (; node != NULL; node = node->sibling)
+   {
+      n++;
+      for (int i = 0; i < MAXCHILDREN; i++)
+         n += count_nodes(node->child[i]);
+   }
+   return n;
+}
+
+// A body can be emitted more than once only if it holds no declarations,
+// no nested loops and no string literals (those all allocate memory on emission).
+bool is_unrollable_body(Node *node)
+{
+   for (; node != NULL; node = node->sibling)
+   {
+      if (node->is_decl || node->nodeType == ToNT || node->nodeType == IterNT ||
+          node->nodeType == StringConstNT)
+         return false;
+      for (int i = 0; i < MAXCHILDREN; i++)
+         if (!is_unrollable_body(node->child[i]))
+            return false;
+   }
+   return true;
+}
+
+// Counts the assignments (=, +=, ++, ...) to the scalar variable name.
+int count_writes(Node *node, char *name)
+{
+   int n = 0;
+   for (; node != NULL; node = node->sibling)
+   {
+      if (node->nodeType == AssignNT && node->child[0] != NULL && node->child[0]->nodeType == IdNT &&
+          strcmp(node->child[0]->literal, name) == 0)
+         n++;
+      for (int i = 0; i < MAXCHILDREN; i++)
+         n += count_writes(node->child[i], name);
+   }
+   return n;
+}
+
+// Is the variable name referenced anywhere in the subtree?
+bool uses_var(Node *node, char *name)
+{
+   for (; node != NULL; node = node->sibling)
+   {
+      if (node->nodeType == IdNT && strcmp(node->literal, name) == 0)
+         return true;
+      for (int i = 0; i < MAXCHILDREN; i++)
+         if (uses_var(node->child[i], name))
+            return true;
+   }
+   return false;
+}
+
+bool has_break(Node *node)
+{
+   for (; node != NULL; node = node->sibling)
+   {
+      if (node->nodeType == BreakNT)
+         return true;
+      for (int i = 0; i < MAXCHILDREN; i++)
+         if (has_break(node->child[i]))
+            return true;
+   }
+   return false;
+}
+
+/* ==================================================
+   UNROLL COPIES
+   ================================================== */
+// Number of body copies to emit: trips (full unroll), unroll_factor (partial)
+// or 0 if the loop should be left alone.
+int unroll_copies(long long trips, int body_size)
+{
+   if (trips <= 0 || trips > INT_MAX)
+      return 0;
+   if (trips <= UNROLL_FULL_TRIPS && trips * body_size <= UNROLL_BUDGET)
+      return trips;
+   if (unroll_factor > 1 && trips >= 2 * unroll_factor && unroll_factor * body_size <= UNROLL_BUDGET)
+      return unroll_factor;
+   return 0;
+}
+
+/* ==================================================
+   MARK COUNTED WHILE LOOPS
+   ================================================== */
+// Recognizes "v <= c0; while v < c1 do begin ... v++; end" (or v !> c1)
+// and records the number of trips in the while node.
+int counted_trips(Node *init, Node *loop)
+{
+   int start, stop;
+   Node *cond = loop->child[0];
+   Node *body = loop->child[1];
+
+   if (init->nodeType != AssignNT || init->tknClass != ASGN || init->child[0]->nodeType != IdNT ||
+       init->child[0]->isArray || !eval_const(init->child[1], &start))
+      return 0;
+   char *var = init->child[0]->literal;
+   if (cond == NULL || cond->nodeType != OpNT || (cond->tknClass != LESS && cond->tknClass != LEQ) ||
+       cond->child[0]->nodeType != IdNT || strcmp(cond->child[0]->literal, var) != 0 ||
+       !eval_const(cond->child[1], &stop))
+      return 0;
+   if (body == NULL || !is_unrollable_body(body))
+      return 0;
+
+   // The increment must be the last statement and the only write to the variable.
+   Node *last = body;
+   if (body->nodeType == CompoundNT)
+   {
+      last = body->child[1];
+      while (last != NULL && last->sibling != NULL)
+         last = last->sibling;
+   }
+   if (last == NULL || last->nodeType != AssignNT || last->tknClass != INC ||
+       last->child[0]->nodeType != IdNT || strcmp(last->child[0]->literal, var) != 0 ||
+       count_writes(body, var) != 1)
+      return 0;
+
+   // The TM computes in 64 bits: the count and the stop value of the
+   // unrolled loop (the variable's value after the loop) must be ints.
+   long long end = (long long)stop + (cond->tknClass == LEQ ? 1 : 0);
+   long long trips = end - start;
+   if (trips <= 0 || trips > INT_MAX || end > INT_MAX)
+      return 0;
+   return trips;
+}
+
+void mark_counted_loops(Node *node)
+{
+   for (; node != NULL; node = node->sibling)
+   {
+      if (node->sibling != NULL && node->sibling->nodeType == IterNT)
+      {
+         node->sibling->trip_count = counted_trips(node, node->sibling);
+      }
+      for (int i = 0; i < MAXCHILDREN; i++)
+         mark_counted_loops(node->child[i]);
+   }
+}
+
+/* ==================================================
+   BREAK SLOT FOR UNROLLED LOOPS
+   ================================================== */
+// Unrolled loops have no loop head, so reserve a jump for 'break' to land on.
+int emit_break_slot(Node *node, Node *body)
+{
+   if (!has_break(body))
+      return -1;
+   emitRM((char *)"JMP", 7, 1, 7, (char *)"Skip over break target");
+   node->break_address = emitSkip(1);
+   return node->break_address;
+}
+
+void backpatch_break_slot(int slot)
+{
+   if (slot < 0)
+      return;
+   int emitLoc = emitWhereAmI();
+   emitNewLoc(slot);
+   emitRM((char *)"JMP", 7, emitLoc - slot - 1, 7, (char *)"Jump past loop [backpatch]");
+   emitNewLoc(emitLoc);
+}
+
+/* ==================================================
+   LOOP FRAME FLOOR
+   ================================================== */
+// The for loops emitted here keep the index, stop value and step in the three
+// slots starting at cdn->location. Compounds nested in their body are sized by
+// semantics without those slots, so while such a body is emitted, temporaries
+// start no higher than loop_floor.
+int loop_floor = 0;
+
+int temp_start(int size)
+{
+   return size < loop_floor ? size : loop_floor;
+}
+
+// Lowers the floor (and toffset) below the slots of the for loop node.
+// Returns the previous floor for the caller to restore.
+int enter_loop_frame(Node *node)
+{
+   int old_floor = loop_floor;
+   int floor = node->size;
+   if (node->child[0]->location - 3 < floor)
+      floor = node->child[0]->location - 3;
+   if (floor < loop_floor)
+      loop_floor = floor;
+   toffset = loop_floor;
+   return old_floor;
+}
+
+/* ==================================================
+   GENERATE UNROLLED FOR
+   ================================================== */
+// Emits a for loop with constant bounds as straight-line copies of its body
+// (full unroll) or as a loop running unroll_factor copies per trip followed by
+// the remaining copies. The index lives where the body reads it (cdn->location).
+// Returns false if the loop does not qualify.
+bool generate_unrolled_for(Node *node)
+{
+   Node *cdn = node->child[0];
+   Node *range = node->child[1];
+   Node *stmt = node->child[2];
+   int first, last, by = 1;
+
+   if (!eval_const(range->child[0], &first) || !eval_const(range->child[1], &last))
+      return false;
+   if (range->child[2] != NULL && !eval_const(range->child[2], &by))
+      return false;
+   long long start = first, stop = last, step = by;
+   if (step == 0 || stmt == NULL || !is_unrollable_body(stmt) || count_writes(stmt, cdn->literal) != 0)
+      return false;
+   if (profile_cold_loop(node))
+      return false;
+
+   long long count = 0;
+   if (step > 0 && start < stop)
+      count = (stop - start + step - 1) / step;
+   else if (step < 0 && start > stop)
+      count = (start - stop - step - 1) / -step;
+   // Index values are loaded as int constants, up to the stop value of the
+   // partial unroll (start + count * step at most).
+   long long end = start + count * step;
+   if (end < INT_MIN || end > INT_MAX)
+      return false;
+   int copies = unroll_copies(count, count_nodes(stmt));
+   if (copies == 0)
+      return false;
+   int trips = count;
+
+   int old_floor = enter_loop_frame(node);
+   if (copies == trips)
+   {
+      emitComment((char *)"UNROLLED FOR trips:", trips);
+      bool uses_index = uses_var(stmt, cdn->literal);
+      int slot = emit_break_slot(node, stmt);
+      for (int k = 0; k < trips; k++)
+      {
+         if (uses_index)
+         {
+            emitRM((char *)"LDC", 3, start + k * step, 6, (char *)"Load unrolled index value");
+            emitRM((char *)"ST", 3, cdn->location, cdn->refType, (char *)"store index", cdn->literal);
+         }
+         generate_for_compound(stmt, node);
+      }
+      backpatch_break_slot(slot);
+   }
+   else
+   {
+      int main_trips = trips / copies;
+      long long limit = start + (long long)main_trips * copies * step;
+      emitComment((char *)"UNROLLED FOR factor:", copies);
+      emitRM((char *)"LDC", 3, start, 6, (char *)"Load starting value");
+      emitRM((char *)"ST", 3, cdn->location, cdn->refType, (char *)"save starting value in index variable");
+      int slot = emit_break_slot(node, stmt);
+      int L1 = emitWhereAmI();
+      for (int k = 0; k < copies; k++)
+      {
+         generate_for_compound(stmt, node);
+         emitRM((char *)"LD", 3, cdn->location, cdn->refType, (char *)"Load index");
+         emitRM((char *)"LDA", 3, step, 3, (char *)"increment");
+         emitRM((char *)"ST", 3, cdn->location, cdn->refType, (char *)"store back to index");
+      }
+      emitComment((char *)"Bottom of unrolled loop test and jump");
+      emitRM((char *)"LD", 4, cdn->location, cdn->refType, (char *)"loop index");
+      emitRM((char *)"LDC", 5, limit, 6, (char *)"unrolled stop value");
+      emitRO((char *)(step > 0 ? "TLT" : "TGT"), 3, 4, 5, (char *)"Op <");
+      emitRM((char *)"JNZ", 3, L1 - emitWhereAmI() - 1, 7, (char *)"go to beginning of loop");
+      for (int k = main_trips * copies; k < trips; k++)
+      {
+         generate_for_compound(stmt, node);
+         if (k != trips - 1)
+         {
+            emitRM((char *)"LD", 3, cdn->location, cdn->refType, (char *)"Load index");
+            emitRM((char *)"LDA", 3, step, 3, (char *)"increment");
+            emitRM((char *)"ST", 3, cdn->location, cdn->refType, (char *)"store back to index");
+         }
+      }
+      backpatch_break_slot(slot);
+   }
+   loop_floor = old_floor;
+   emitComment((char *)"END LOOP");
+   count_changes(PASS_UNROLL, 1);
+   return true;
+}
+
+/* ==================================================
+   GENERATE UNROLLED WHILE
+   ================================================== */
+// Emits a counted while loop (see mark_counted_loops) the same way. The body
+// keeps its own increment, so the variable ends up with its usual final value.
+bool generate_unrolled_while(Node *node)
+{
+   Node *A = node->child[0];
+   Node *B = node->child[1];
+   int trips = node->trip_count;
+
+   if (trips <= 0 || profile_cold_loop(node))
+      return false;
+   Node *var = fetchSymbol(A->child[0], &gcST);
+   if (var == NULL || var->refType != LocalRT || var->isStatic)
+      return false;
+   int copies = unroll_copies(trips, count_nodes(B));
+   if (copies == 0)
+      return false;
+
+   int start;
+   eval_const(A->child[1], &start);
+   start -= trips - (A->tknClass == LEQ ? 1 : 0);
+   if (copies == trips)
+   {
+      emitComment((char *)"UNROLLED WHILE trips:", trips);
+      int slot = emit_break_slot(node, B);
+      for (int k = 0; k < trips; k++)
+      {
+         generate_while_compound(B, node);
+      }
+      backpatch_break_slot(slot);
+   }
+   else
+   {
+      int main_trips = trips / copies;
+      emitComment((char *)"UNROLLED WHILE factor:", copies);
+      int slot = emit_break_slot(node, B);
+      int L1 = emitWhereAmI();
+      for (int k = 0; k < copies; k++)
+      {
+         generate_while_compound(B, node);
+      }
+      emitComment((char *)"Bottom of unrolled loop test and jump");
+      emitRM((char *)"LD", 4, var->location, var->refType, (char *)"Load variable", var->literal);
+      emitRM((char *)"LDC", 5, start + main_trips * copies, 6, (char *)"unrolled stop value");
+      emitRO((char *)"TLT", 3, 4, 5, (char *)"Op <");
+      emitRM((char *)"JNZ", 3, L1 - emitWhereAmI() - 1, 7, (char *)"go to beginning of loop");
+      for (int k = main_trips * copies; k < trips; k++)
+      {
+         generate_while_compound(B, node);
+      }
+      backpatch_break_slot(slot);
+   }
+   emitComment((char *)"END WHILE");
+   count_changes(PASS_UNROLL, 1);
+   return true;
+}
+
+/* ==================================================
+   REGISTER-RESIDENT FOR LOOPS
+   ================================================== */
+// While the body of such a loop is emitted, the index lives in AC3 and the
+// stop value in RT. Both are written back/reloaded around anything that
+// clobbers them (calls and array copies/compares).
+Node *reg_loop = NULL;
+
+bool has_for(Node *node)
+{
+   for (; node != NULL; node = node->sibling)
+   {
+      if (node->nodeType == ToNT)
+         return true;
+      for (int i = 0; i < MAXCHILDREN; i++)
+         if (has_for(node->child[i]))
+            return true;
+   }
+   return false;
+}
+
+// Emits the value of a range expression into AC.
+bool load_range_value(Node *node)
+{
+   if (load_in(node))
+      return true;
+   switch (node->nodeType)
+   {
+   case OpNT:
+      generate_op(node);
+      return true;
+   case SignNT:
+      generate_ChSign(node);
+      return true;
+   case SizeOfNT:
+      generate_sizeof(node);
+      return true;
+   case ArrNT:
+      load_arr_op(node);
+      return true;
+   case CallNT:
+      generate_call(node);
+      return true;
+   }
+   return false;
+}
+
+// Is the variable the index of the register-resident loop being emitted?
+bool is_reg_index(Node *sym)
+{
+   return reg_loop != NULL && reg_loop->child[0] == sym;
+}
+
+void spill_loop_regs()
+{
+   store_promoted_globals();
+   if (reg_loop == NULL)
+      return;
+   Node *cdn = reg_loop->child[0];
+   emitRM((char *)"ST", AC3, cdn->location, cdn->refType, (char *)"Spill loop index", cdn->literal);
+}
+
+void reload_loop_regs()
+{
+   load_promoted_globals();
+   if (reg_loop == NULL)
+      return;
+   Node *cdn = reg_loop->child[0];
+   emitRM((char *)"LD", AC3, cdn->location, cdn->refType, (char *)"Reload loop index", cdn->literal);
+   emitRM((char *)"LD", RT, cdn->location - 1, cdn->refType, (char *)"Reload stop value");
+}
+
+// Emits a for loop with a constant step whose index, stop value and step stay
+// in registers. Only innermost for loops whose body leaves the index alone
+// qualify. Returns false if the loop does not qualify.
+bool generate_register_for(Node *node)
+{
+   Node *cdn = node->child[0];
+   Node *range = node->child[1];
+   Node *stmt = node->child[2];
+   int step = 1;
+
+   if (range->child[2] != NULL && !eval_const(range->child[2], &step))
+      return false;
+   if (stmt == NULL || has_for(stmt) || count_writes(stmt, cdn->literal) != 0)
+      return false;
+
+   emitComment((char *)"REGISTER FOR");
+   int old_floor = enter_loop_frame(node);
+   load_range_value(range->child[0]);
+   emitRM((char *)"ST", 3, cdn->location, cdn->refType, (char *)"save starting value in index variable");
+   load_range_value(range->child[1]);
+   emitRM((char *)"ST", 3, cdn->location - 1, cdn->refType, (char *)"save stop value");
+   emitRM((char *)"LDA", RT, 0, 3, (char *)"stop value in register");
+   emitRM((char *)"LD", AC3, cdn->location, cdn->refType, (char *)"loop index in register");
+   int L1 = emitWhereAmI();
+   emitRO((char *)(step > 0 ? "TLT" : "TGT"), 3, AC3, RT, (char *)"Op <");
+   emitRM((char *)"JNZ", 3, 1, 7, (char *)"Jump to loop body");
+   int backpatch = node->break_address = emitSkip(1);
+   toffset = loop_floor;
+   reg_loop = node;
+   generate_for_compound(stmt, node);
+   reg_loop = NULL;
+   emitComment((char *)"Bottom of loop increment and jump");
+   emitRM((char *)"LDA", AC3, step, AC3, (char *)"increment index in register");
+   if (rotate_flag)
+   {
+      emitRO((char *)(step > 0 ? "TLT" : "TGT"), 3, AC3, RT, (char *)"Op <");
+      emitRM((char *)"JNZ", 3, backpatch - emitWhereAmI(), 7, (char *)"go to top of loop body");
+   }
+   else
+   {
+      emitRM((char *)"JMP", 7, L1 - emitWhereAmI() - 1, 7, (char *)"go to beginning of loop");
+   }
+   int emitLoc = emitWhereAmI();
+   emitNewLoc(backpatch);
+   emitRM((char *)"JMP", 7, emitLoc - backpatch - 1, 7, (char *)"Jump past loop [backpatch]");
+   emitNewLoc(emitLoc);
+   loop_floor = old_floor;
+   emitComment((char *)"END LOOP");
+   count_changes(PASS_REGLOOP, 1);
+   return true;
+}
+
+/* ==================================================
+   ROTATED LOOPS
+   ================================================== */
+// Rotated loops test once on entry and then at the bottom of the body,
+// jumping straight back to the body:
+//
+//    t1 = E                   guard
+//    if_false t1 goto L2      <- backpatch (also the break target)
+//    L1: A
+//    t1 = E                   bottom test
+//    if t1 goto L1
+//    L2:
+//
+// The condition is emitted twice, so conditions holding string constants
+// (which allocate memory on emission) are left alone.
+bool has_string(Node *node)
+{
+   for (; node != NULL; node = node->sibling)
+   {
+      if (node->nodeType == StringConstNT)
+         return true;
+      for (int i = 0; i < MAXCHILDREN; i++)
+         if (has_string(node->child[i]))
+            return true;
+   }
+   return false;
+}
+
+bool generate_rotated_while(Node *node)
+{
+   Node *A = node->child[0];
+   Node *B = node->child[1];
+
+   if (has_string(A))
+      return false;
+   emitComment((char *)"WHILE (rotated)");
+   gc_traverse_sibs(A);
+   emitRM((char *)"JNZ", 3, 1, 7, (char *)"Jump to while part");
+   int rememberbp = node->break_address = emitSkip(1);
+   emitComment((char *)"DO");
+   generate_while_compound(B, node);
+   emitComment((char *)"Bottom of loop test");
+   gc_traverse_sibs(A);
+   emitRM((char *)"JNZ", 3, rememberbp - emitWhereAmI(), 7, (char *)"go to top of loop body");
+   int emitLoc = emitWhereAmI();
+   emitNewLoc(rememberbp);
+   emitRM((char *)"JMP", 7, emitLoc - rememberbp - 1, 7, (char *)"Jump past loop [backpatch]");
+   emitNewLoc(emitLoc);
+   emitComment((char *)"END WHILE");
+   count_changes(PASS_ROTATE, 1);
+   return true;
+}
+
+// Same shape for a for loop whose index, stop value and step live in the
+// frame at cdn->location, cdn->location-1 and cdn->location-2.
+bool generate_rotated_for(Node *node)
+{
+   Node *cdn = node->child[0];
+   Node *range = node->child[1];
+   Node *stmt = node->child[2];
+
+   if (stmt == NULL)
+      return false;
+   emitComment((char *)"FOR (rotated)");
+   int old_floor = enter_loop_frame(node);
+   load_range_value(range->child[0]);
+   emitRM((char *)"ST", 3, cdn->location, cdn->refType, (char *)"save starting value in index variable");
+   load_range_value(range->child[1]);
+   emitRM((char *)"ST", 3, cdn->location - 1, cdn->refType, (char *)"save stop value");
+   if (range->child[2] == NULL)
+      emitRM((char *)"LDC", 3, 1, 6, (char *)"default increment by 1");
+   else
+      load_range_value(range->child[2]);
+   emitRM((char *)"ST", 3, cdn->location - 2, cdn->refType, (char *)"save step value");
+   emitRM((char *)"LD", 4, cdn->location, cdn->refType, (char *)"loop index");
+   emitRM((char *)"LD", 5, cdn->location - 1, cdn->refType, (char *)"stop value");
+   emitRO((char *)"SLT", 3, 4, 5, (char *)"Op <");
+   emitRM((char *)"JNZ", 3, 1, 7, (char *)"Jump to loop body");
+   int backpatch = node->break_address = emitSkip(1);
+   toffset = loop_floor;
+   generate_for_compound(stmt, node);
+   emitComment((char *)"Bottom of loop increment and test");
+   emitRM((char *)"LD", 4, cdn->location, cdn->refType, (char *)"Load index");
+   emitRM((char *)"LD", 3, cdn->location - 2, cdn->refType, (char *)"Load step");
+   emitRO((char *)"ADD", 4, 4, 3, (char *)"increment");
+   emitRM((char *)"ST", 4, cdn->location, cdn->refType, (char *)"store back to index");
+   emitRM((char *)"LD", 5, cdn->location - 1, cdn->refType, (char *)"stop value");
+   emitRO((char *)"SLT", 3, 4, 5, (char *)"Op <");
+   emitRM((char *)"JNZ", 3, backpatch - emitWhereAmI(), 7, (char *)"go to top of loop body");
+   int emitLoc = emitWhereAmI();
+   emitNewLoc(backpatch);
+   emitRM((char *)"JMP", 7, emitLoc - backpatch - 1, 7, (char *)"Jump past loop [backpatch]");
+   emitNewLoc(emitLoc);
+   loop_floor = old_floor;
+   emitComment((char *)"END LOOP");
+   count_changes(PASS_ROTATE, 1);
+   return true;
+}
+
+/* ==================================================
+   GLOBALS PROMOTED TO REGISTERS
+   ================================================== */
+// While a promoted loop is emitted, its hottest global scalars live in AC3
+// and RT: loaded once before the loop and stored back once after it (and
+// before a return). Only loops whose calls leave those globals alone are
+// promoted; the registers are still written back/reloaded around anything
+// that clobbers them, like the register-resident for loops.
+
+#define PROMOTE_MAX 2      // Registers available for globals.
+#define PROMOTE_MIN_REFS 2 // References needed in the loop to promote a global.
+
+static const int promote_regs[PROMOTE_MAX] = {AC3, RT};
+static Node *promoted[PROMOTE_MAX];
+static int promoted_count = 0;
+
+// Register holding the variable, or -1.
+int var_reg(Node *sym)
+{
+   if (is_reg_index(sym))
+      return AC3;
+   for (int i = 0; i < promoted_count; i++)
+      if (promoted[i] == sym)
+         return promote_regs[i];
+   return -1;
+}
+
+// Register holding the scalar variable read by node, or -1.
+int operand_reg(Node *node)
+{
+   if (node == NULL || node->nodeType != IdNT || node->isArray || node->isStatic)
+      return -1;
+   return var_reg(fetchSymbol(node, &gcST));
+}
+
+// The global scalar (no static, no array) name refers to here, or NULL.
+static Node *global_scalar(char *name)
+{
+   string static_name = string(name) + "-ST";
+   if (gcST.lookup(static_name) != NULL)
+      return NULL;
+   Node *sym = gcST.lookup(name);
+   if (sym == NULL)
+      sym = gcST.lookupGlobal(name);
+   if (sym == NULL || sym->nodeType != VarNT || sym->refType != GlobalRT || sym->isArray || sym->isStatic)
+      return NULL;
+   return sym;
+}
+
+// Output routines leave every register but AC and AC1 alone, inlined I/O
+// calls every register but AC.
+bool keeps_regs(Node *func)
+{
+   return func != NULL && func->isLib && (func->dataType == VoidDT || inline_io_flag);
+}
+
+static void count_global_refs(Node *node, map<Node *, int> &refs, int *calls)
+{
+   for (; node != NULL; node = node->sibling)
+   {
+      if (node->nodeType == IdNT && !node->isArray)
+      {
+         Node *sym = global_scalar(node->literal);
+         if (sym != NULL)
+            refs[sym]++;
+      }
+      if (node->nodeType == CallNT && !keeps_regs(gcST.lookupGlobal(node->literal)))
+         (*calls)++;
+      for (int i = 0; i < MAXCHILDREN; i++)
+         count_global_refs(node->child[i], refs, calls);
+   }
+}
+
+// Can a call in the subtree reach code that names the global? Functions not
+// emitted yet are unknown and assumed to.
+static bool calls_touch(Node *node, char *name, set<Node *> &seen)
+{
+   for (; node != NULL; node = node->sibling)
+   {
+      if (node->nodeType == CallNT)
+      {
+         Node *func = gcST.lookupGlobal(node->literal);
+         if (func == NULL)
+            return true;
+         if (!func->isLib && seen.insert(func).second &&
+             (uses_var(func->child[1], name) || calls_touch(func->child[1], name, seen)))
+            return true;
+      }
+      for (int i = 0; i < MAXCHILDREN; i++)
+         if (calls_touch(node->child[i], name, seen))
+            return true;
+   }
+   return false;
+}
+
+// Picks the globals of the loop worth keeping in registers and loads them.
+// Returns false (emitting nothing) if none qualify.
+bool promote_loop_globals(Node *node)
+{
+   if (reg_loop != NULL || promoted_count > 0)
+      return false;
+   // The register-resident for loops need the same registers.
+   if (regloop_flag && (node->nodeType == ToNT || has_for(node->child[1]) || has_for(node->child[2])))
+      return false;
+
+   map<Node *, int> refs;
+   int calls = 0;
+   for (int i = 0; i < MAXCHILDREN; i++)
+      count_global_refs(node->child[i], refs, &calls);
+
+   vector<pair<int, Node *> > hot;
+   for (map<Node *, int>::iterator it = refs.begin(); it != refs.end(); it++)
+   {
+      set<Node *> seen;
+      // Each clobbering call costs a store and a reload per promoted global.
+      if (it->second < PROMOTE_MIN_REFS || it->second <= 2 * calls)
+         continue;
+      bool touched = false;
+      for (int i = 0; i < MAXCHILDREN && !touched; i++)
+         touched = calls_touch(node->child[i], it->first->literal, seen);
+      if (!touched)
+         hot.push_back(make_pair(-it->second, it->first));
+   }
+   if (hot.empty())
+      return false;
+   sort(hot.begin(), hot.end());
+
+   emitComment((char *)"PROMOTE GLOBALS");
+   for (size_t i = 0; i < hot.size() && promoted_count < PROMOTE_MAX; i++)
+   {
+      Node *sym = hot[i].second;
+      promoted[promoted_count] = sym;
+      emitRM((char *)"LD", promote_regs[promoted_count], sym->location, sym->refType, (char *)"Global to register", sym->literal);
+      promoted_count++;
+   }
+   count_changes(PASS_PROMOTE, promoted_count);
+   return true;
+}
+
+void store_promoted_globals()
+{
+   for (int i = 0; i < promoted_count; i++)
+      emitRM((char *)"ST", promote_regs[i], promoted[i]->location, promoted[i]->refType, (char *)"Store global from register", promoted[i]->literal);
+}
+
+void load_promoted_globals()
+{
+   for (int i = 0; i < promoted_count; i++)
+      emitRM((char *)"LD", promote_regs[i], promoted[i]->location, promoted[i]->refType, (char *)"Reload global to register", promoted[i]->literal);
+}
+
+// Writes the promoted globals back once the loop is done.
+void demote_loop_globals()
+{
+   emitComment((char *)"DEMOTE GLOBALS");
+   store_promoted_globals();
+   promoted_count = 0;
+}
+
+/* ==================================================
+   ARRAY FILL AND COPY LOOPS
+   ================================================== */
+// A loop over consecutive indexes whose body only assigns array elements at
+// the index
+//    while i < E do begin a[i] <= v; b[i] <= c[i]; i++; end
+//    for i <= S .. E do a[i] <= v;
+// becomes one SET (fill with v) or MOV (copy) per statement over the
+// n = max(E - i, 0) elements. Element k of an array is at base - k and
+// SET/MOV walk down from the first element like the loop does, so aliased
+// array parameters see the same writes; every access is at the loop index,
+// so the statements may run one after the other.
+
+// Is node "a[var]"?
+static bool is_indexed_by(Node *node, char *var)
+{
+   return node != NULL && node->nodeType == ArrNT && node->child[0]->nodeType == IdNT && node->child[1] != NULL &&
+          node->child[1]->nodeType == IdNT && strcmp(node->child[1]->literal, var) == 0;
+}
+
+// Is node a constant or a scalar in memory (load_in() only touches AC)?
+static bool is_plain_operand(Node *node, char *var)
+{
+   if (node->isArray)
+      return false;
+   if (node->isConst)
+      return true;
+   return node->nodeType == IdNT && strcmp(node->literal, var) != 0 && operand_reg(node) < 0;
+}
+
+// "a[var] <= v" or "a[var] <= b[var]"
+static bool is_bulk_assign(Node *stmt, char *var)
+{
+   if (stmt->nodeType != AssignNT || stmt->tknClass != ASGN || !is_indexed_by(stmt->child[0], var))
+      return false;
+   Node *rhs = stmt->child[1];
+   return is_indexed_by(rhs, var) || is_plain_operand(rhs, var);
+}
+
+// "var++", "var += 1" or "var <= var + 1"
+static bool is_increment(Node *stmt, char *var)
+{
+   int one;
+   if (stmt->nodeType != AssignNT || stmt->child[0]->nodeType != IdNT || strcmp(stmt->child[0]->literal, var) != 0)
+      return false;
+   if (stmt->tknClass == INC)
+      return true;
+   Node *rhs = stmt->child[1];
+   if (stmt->tknClass == ADDASS)
+      return eval_const(rhs, &one) && one == 1;
+   if (stmt->tknClass != ASGN || rhs->nodeType != OpNT || rhs->tknClass != ADD)
+      return false;
+   for (int k = 0; k < 2; k++)
+      if (rhs->child[k]->nodeType == IdNT && strcmp(rhs->child[k]->literal, var) == 0 &&
+          eval_const(rhs->child[1 - k], &one) && one == 1)
+         return true;
+   return false;
+}
+
+// Collects the assignments of a fill/copy body (without the increment of a
+// while loop). False if the body does anything else.
+static bool bulk_body(Node *body, char *var, bool increment, vector<Node *> &stmts)
+{
+   Node *list = body;
+   if (body->nodeType == CompoundNT)
+   {
+      if (body->child[0] != NULL)
+         return false;
+      list = body->child[1];
+   }
+   for (Node *stmt = list; stmt != NULL; stmt = stmt->sibling)
+      stmts.push_back(stmt);
+   if (increment)
+   {
+      if (stmts.empty() || !is_increment(stmts.back(), var))
+         return false;
+      stmts.pop_back();
+   }
+   if (stmts.empty())
+      return false;
+   for (size_t i = 0; i < stmts.size(); i++)
+      if (!is_bulk_assign(stmts[i], var))
+         return false;
+   return true;
+}
+
+static void load_array_base(int reg, Node *id)
+{
+   Node *sym = fetchSymbol(id, &gcST);
+   if (sym->nodeType == ParmArrNT)
+      emitRM((char *)"LD", reg, sym->location, sym->refType, (char *)"Load address of base of array", sym->literal);
+   else
+      emitRM((char *)"LDA", reg, sym->location, sym->refType, (char *)"Load address of base of array", sym->literal);
+}
+
+// With the first index in AC1 and the stop value in AC2, fills/copies the
+// elements and leaves their number in AC2.
+static void emit_bulk(vector<Node *> &stmts)
+{
+   emitRO((char *)"SUB", AC2, AC2, AC1, (char *)"Elements: stop - index");
+   emitRM((char *)"LDC", AC3, 0, 6, (char *)"Load 0");
+   emitRO((char *)"SWP", AC3, AC2, AC2, (char *)"AC2 <- max(AC2, 0)");
+   for (size_t i = 0; i < stmts.size(); i++)
+   {
+      Node *lhs = stmts[i]->child[0];
+      Node *rhs = stmts[i]->child[1];
+      if (rhs->nodeType == ArrNT)
+      {
+         load_array_base(AC, rhs->child[0]);
+         emitRO((char *)"SUB", AC, AC, AC1, (char *)"First element copied");
+         load_array_base(AC3, lhs->child[0]);
+         emitRO((char *)"SUB", AC3, AC3, AC1, (char *)"First element written");
+         emitRO((char *)"MOV", AC3, AC, AC2, (char *)"Copy the elements", lhs->child[0]->literal);
+      }
+      else
+      {
+         load_in(rhs);
+         load_array_base(AC3, lhs->child[0]);
+         emitRO((char *)"SUB", AC3, AC3, AC1, (char *)"First element written");
+         emitRO((char *)"SET", AC3, AC, AC2, (char *)"Fill the elements", lhs->child[0]->literal);
+      }
+   }
+}
+
+// "while i < E" (or i !> E) with E a constant or scalar and the body above.
+// i ends up at max(i, E) like after the loop.
+bool generate_bulk_while(Node *node)
+{
+   Node *cond = node->child[0];
+   vector<Node *> stmts;
+   if (cond == NULL || cond->nodeType != OpNT || (cond->tknClass != LESS && cond->tknClass != LEQ))
+      return false;
+   Node *index = cond->child[0];
+   Node *stop = cond->child[1];
+   if (index->nodeType != IdNT || index->isArray || index->isStatic)
+      return false;
+   char *var = index->literal;
+   if (!is_plain_operand(stop, var) || node->child[1] == NULL || !bulk_body(node->child[1], var, true, stmts))
+      return false;
+
+   emitComment((char *)"WHILE (fill/copy)");
+   load_in(index);
+   emitRM((char *)"LDA", AC1, 0, AC, (char *)"AC1 <- index");
+   load_in(stop);
+   emitRM((char *)"LDA", AC2, cond->tknClass == LEQ ? 1 : 0, AC, (char *)"AC2 <- stop");
+   spill_loop_regs();
+   emit_bulk(stmts);
+   reload_loop_regs();
+   emitRO((char *)"ADD", AC, AC1, AC2, (char *)"Index after the loop");
+   store_var(index);
+   emitComment((char *)"END WHILE");
+   count_changes(PASS_IDIOM, 1);
+   return true;
+}
+
+// "for i <= S .. E" (step 1) with S and E constants or scalars. The index
+// is not visible after the loop.
+bool generate_bulk_for(Node *node)
+{
+   Node *cdn = node->child[0];
+   Node *range = node->child[1];
+   vector<Node *> stmts;
+   int step;
+   if (range->child[2] != NULL && (!eval_const(range->child[2], &step) || step != 1))
+      return false;
+   if (!is_plain_operand(range->child[0], cdn->literal) || !is_plain_operand(range->child[1], cdn->literal) ||
+       node->child[2] == NULL || !bulk_body(node->child[2], cdn->literal, false, stmts))
+      return false;
+
+   emitComment((char *)"FOR (fill/copy)");
+   load_in(range->child[0]);
+   emitRM((char *)"LDA", AC1, 0, AC, (char *)"AC1 <- start");
+   load_in(range->child[1]);
+   emitRM((char *)"LDA", AC2, 0, AC, (char *)"AC2 <- stop");
+   spill_loop_regs();
+   emit_bulk(stmts);
+   reload_loop_regs();
+   emitComment((char *)"END FOR");
+   count_changes(PASS_IDIOM, 1);
+   return true;
+}
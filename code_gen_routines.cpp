@@ -1,955 +1,1295 @@
-#include "code_gen.hpp"
-
-extern FILE *code;
-extern int goffset;
-
-extern SymbolTable gcST;
-extern int toffset;
-extern int address_of_main;
-extern Node *curr_decl;
-
-extern bool in_loop;
-extern Node *loop;
-extern Node *embedded_loop;
-
-Node *current_function = NULL;
-int string_offset = -1;
-
-/* ==================================================
-   GENERATE FUNCTION
-   ================================================== */
-void generate_function(Node *func)
-{
-   gcST.insert(func->literal, func);
-   gcST.enter(func->literal);
-   current_function = func;
-   int toffset_temp = toffset;
-   toffset = func->size;
-   func->address = emitWhereAmI();
-   if (func->isMain)
-   {
-      address_of_main = func->address;
-   }
-   emitComment((char *)"** ** ** ** ** ** ** ** ** ** ** **");
-   emitComment((char *)"FUNCTION", func->literal);
-   emitComment((char *)"TOFF set:", toffset);
-   emitRM((char *)"ST", 3, -1, 1, (char *)"Store return address");
-   gc_traverse_children(func);
-   emitComment((char *)"Add standard closing in case there is no return statement");
-   emitRM((char *)"LDC", 2, 0, 6, (char *)"Set return value to 0");
-   emitRM((char *)"LD", 3, -1, 1, (char *)"Load return address");
-   emitRM((char *)"LD", 1, 0, 1, (char *)"Adjust fp");
-   emitRM((char *)"JMP", 7, 0, 3, (char *)"Return");
-   toffset = toffset_temp;
-   emitComment((char *)"END FUNCTION", func->literal);
-   if (!func->isMain)
-   {
-      emitComment((char *)"");
-   }
-   gcST.leave();
-}
-
-/* ==================================================
-   GENERATE FUNCTION COMPOUND
-   ================================================== */
-void generate_function_compound(Node *node)
-{
-   int toffset_temp = toffset;
-   toffset = node->size;
-   emitComment((char *)"COMPOUND");
-   emitComment((char *)"TOFF set:", toffset);
-   gc_traverse_sibs(node->child[0]); // Declarations
-   emitComment((char *)"Compound Body");
-   gc_traverse_children(node);
-   toffset = toffset_temp;
-   emitComment((char *)"TOFF set:", toffset);
-   emitComment((char *)"END COMPOUND");
-}
-
-/* ==================================================
-   GENERATE FUNCTION COMPOUND
-   ================================================== */
-void generate_compound(Node *node)
-{
-   gcST.enter("Compound");
-   int toffset_temp = toffset;
-   toffset = node->size;
-   emitComment((char *)"COMPOUND");
-   emitComment((char *)"TOFF set:", toffset);
-   gc_traverse_sibs(node->child[0]); // Declarations
-   emitComment((char *)"Compound Body");
-   gc_traverse_children(node);
-   toffset = toffset_temp;
-   emitComment((char *)"TOFF set:", toffset);
-   emitComment((char *)"END COMPOUND");
-   gcST.leave();
-}
-
-/* ==================================================
-   GENERATE OPERATORS
-   ================================================== */
-void generate_op(Node *node)
-{
-   Node *lhs = node->child[0];
-   Node *rhs = node->child[1];
-
-   // 1. Load LHS
-   if (load_in(lhs) == false)
-   {
-      // If LHS is an array...
-      if (load_arr_op(lhs) == false)
-      {
-         // For any other nodetypes...
-         switch (lhs->nodeType)
-         {
-         case OpNT:
-            generate_op(lhs);
-            break;
-         case QuesNT:
-            generate_Ques(lhs);
-            break;
-         case SignNT:
-            generate_ChSign(lhs);
-            break;
-         case CallNT:
-            generate_call(lhs);
-            break;
-         case AssignNT:
-            generate_assignment(lhs);
-            break;
-         case SizeOfNT:
-            generate_sizeof(lhs);
-            break;
-         }
-         emitRM((char *)"ST", 3, toffset, 1, (char *)"Push left side");
-      }
-      else
-      {
-         emitRM((char *)"ST", 3, toffset, 1, (char *)"Push left side");
-      }
-   }
-   else
-   {
-      emitRM((char *)"ST", 3, toffset, 1, (char *)"Push left side");
-   }
-   toffset -= 1;
-   emitComment((char *)"TOFF dec:", toffset);
-   // 2. Load RHS
-   if (load_in(rhs) == false)
-   {
-      // If RHS is an array...
-      if (load_arr_op(rhs) == false)
-      {
-         // For any other nodetypes...
-         switch (rhs->nodeType)
-         {
-         case OpNT:
-            generate_op(rhs);
-            break;
-         case QuesNT:
-            generate_Ques(rhs);
-            break;
-         case SignNT:
-            generate_ChSign(rhs);
-            break;
-         case CallNT:
-            generate_call(rhs);
-            break;
-         case SizeOfNT:
-            generate_sizeof(rhs);
-            break;
-         }
-      }
-   }
-   toffset += 1;
-   emitComment((char *)"TOFF inc:", toffset);
-   emitRM((char *)"LD", 4, toffset, 1, (char *)"Pop left into ac1");
-   if (rhs->isArray && rhs->dataType == CharDT)
-   {
-      emitRM((char *)"LD", AC2, 1, 3, (char *)"AC2 <- |RHS|");
-      emitRM((char *)"LD", AC3, 1, 4, (char *)"AC3 <- |LHS|");
-      emitRM((char *)"LDA", 2, 0, 5, (char *)"R2 <- |RHS|");
-      emitRO((char *)"SWP", 5, 6, 6, (char *)"pick smallest size");
-      emitRM((char *)"LD", AC3, 1, 4, (char *)"AC3 <- |LHS|");
-      emitRO((char *)"CO", 4, 3, 5, (char *)"setup array compare  LHS vs RHS");
-      emitRO((char *)"TNE", 5, AC1, AC, (char *)"if not equal then test (AC1, AC)");
-      emitRO((char *)"JNZ", 5, 2, 7, (char *)"jump not equal");
-      emitRM((char *)"LDA", AC, 0, 2, (char *)"AC1 <- |RHS|");
-      emitRM((char *)"LDA", AC1, 0, 6, (char *)"AC <- |LHS|");
-   }
-   switch (node->tknClass)
-   {
-   case MUL:
-      emitRO((char *)"MUL", 3, 4, 3, (char *)"Op *");
-      break;
-   case ADD:
-      emitRO((char *)"ADD", 3, 4, 3, (char *)"Op +");
-      break;
-   case SUB:
-      emitRO((char *)"SUB", 3, 4, 3, (char *)"Op -");
-      break;
-   case DIV:
-      emitRO((char *)"DIV", 3, 4, 3, (char *)"Op /");
-      break;
-   case MOD:
-      emitRO((char *)"MOD", 3, 4, 3, (char *)"Op %");
-      break;
-   case EQL:
-      emitRO((char *)"TEQ", 3, 4, 3, (char *)"Op =");
-      break;
-   case GREAT:
-      emitRO((char *)"TGT", 3, 4, 3, (char *)"Op >");
-      break;
-   case LESS:
-      emitRO((char *)"TLT", 3, 4, 3, (char *)"Op <");
-      break;
-   case LEQ:
-      emitRO((char *)"TLE", 3, 4, 3, (char *)"Op <=");
-      break;
-   case GEQ:
-      emitRO((char *)"TGE", 3, 4, 3, (char *)"Op >=");
-      break;
-   case NEQ:
-      emitRO((char *)"TNE", 3, 4, 3, (char *)"Op ><");
-      break;
-   }
-}
-
-/* ==================================================
-   GENERATE ASSIGNMENTS
-   ================================================== */
-void generate_assignment(Node *node)
-{
-   Node *lhs = node->child[0];
-   Node *rhs = node->child[1];
-
-   if (node->tknClass == ASGN)
-   {
-      // Check if LHS is an Array
-      if (load_arr_assign(lhs, rhs) == false)
-      {
-         // 1. Check RHS
-         if (load_in(rhs) == false)
-         {
-            switch (rhs->nodeType)
-            {
-            case AssignNT:
-               generate_assignment(rhs);
-               break;
-            case OpNT:
-               generate_op(rhs);
-               break;
-            case CallNT:
-               generate_call(rhs);
-               break;
-            case AndNT:
-               generate_and_or(rhs);
-               break;
-            case OrNT:
-               generate_and_or(rhs);
-               break;
-            case NotNT:
-               generate_not(rhs);
-               break;
-            case SignNT:
-               generate_ChSign(rhs);
-               break;
-            case ArrNT:
-               load_arr_op(rhs);
-               break;
-            }
-         }
-         // 2. Store LHS
-         if (rhs->isArray && rhs->nodeType == IdNT)
-         {
-            emitRM((char *)"LDA", 4, lhs->location, 1, (char *)"address of lhs");
-            emitRM((char *)"LD", 5, 1, 3, (char *)"size of rhs");
-            emitRM((char *)"LD", 6, 1, 4, (char *)"size of lhs");
-            emitRO((char *)"SWP", 5, 6, 6, (char *)"pick smallest size");
-            emitRO((char *)"MOV", 4, 3, 5, (char *)"array op =");
-         }
-         else
-         {
-            store_var(lhs);
-         }
-      }
-      else
-      {
-         emitRM((char *)"ST", 3, 0, 5, (char *)"Store variable", lhs->child[0]->literal);
-      }
-   }
-   else if (node->tknClass == ADDASS || node->tknClass == SUBASS ||
-            node->tknClass == MULASS || node->tknClass == DIVASS)
-   {
-      char *cmd = NULL;
-      char *out_msg = NULL;
-
-      switch (node->tknClass)
-      {
-      case ADDASS:
-         cmd = (char *)"ADD\0";
-         out_msg = (char *)"op +=\0";
-         break;
-      case SUBASS:
-         cmd = (char *)"SUB\0";
-         out_msg = (char *)"op -=\0";
-         break;
-      case MULASS:
-         cmd = (char *)"MUL\0";
-         out_msg = (char *)"op *=\0";
-         break;
-      case DIVASS:
-         cmd = (char *)"DIV\0";
-         out_msg = (char *)"op /=\0";
-         break;
-      }
-
-      // Check if LHS is an Array
-      if (load_arr_assign(lhs, rhs) == false)
-      {
-         // 1. Check RHS
-         if (load_in(rhs) == false)
-         {
-            switch (rhs->nodeType)
-            {
-            case AssignNT:
-               generate_assignment(rhs);
-               break;
-            case ArrNT:
-               load_arr_op(rhs);
-               break;
-            case OpNT:
-               generate_op(rhs);
-               break;
-            }
-         }
-         Node *sym = fetchSymbol(lhs, &gcST);
-         emitRM((char *)"LD", 4, sym->location, sym->refType, (char *)"load lhs variable", sym->literal);
-         emitRO(cmd, 3, 4, 3, out_msg);
-         if (lhs->nodeType == ArrNT)
-            emitRM((char *)"ST", 3, sym->location, sym->refType, (char *)"Store variable", sym->literal);
-         //  2. Store LHS
-         store_var(lhs);
-      }
-      else
-      {
-         Node *sym = fetchSymbol(lhs->child[0], &gcST);
-         emitRM((char *)"LD", 4, 0, 5, (char *)"load lhs variable", sym->literal);
-         emitRO(cmd, 3, 4, 3, out_msg);
-         if (lhs->nodeType == ArrNT)
-            emitRM((char *)"ST", 3, 0, 5, (char *)"Store variable", sym->literal);
-      }
-   }
-   else if (node->tknClass == INC || node->tknClass == DEC)
-   {
-      Node *val = node->child[0];
-      if (val->nodeType == IdNT)
-      {
-         Node *id = fetchSymbol(val, &gcST);
-         emitRM((char *)"LD", 3, id->location, id->refType, (char *)"load lhs variable", id->literal);
-         if (node->tknClass == INC)
-         {
-            emitRM((char *)"LDA", 3, 1, 3, (char *)"increment value of", val->literal);
-         }
-         else
-         {
-            emitRM((char *)"LDA", 3, -1, 3, (char *)"decrement value of", val->literal);
-         }
-         store_var(val);
-      }
-      else if (val->nodeType == ArrNT)
-      {
-         Node *id = fetchSymbol(val->child[0], &gcST);
-         Node *idx = val->child[1];
-         load_in(idx);
-         if (id->nodeType == ParmArrNT)
-         {
-            emitRM((char *)"LD", AC2, id->location, id->refType, (char *)"Load address of base of array", id->literal);
-         }
-         else
-         {
-            emitRM((char *)"LDA", AC2, id->location, id->refType, (char *)"Load address of base of array", id->literal);
-         }
-         emitRO((char *)"SUB", 5, 5, 3, (char *)"Compute offset of value");
-         emitRM((char *)"LD", 3, 0, 5, (char *)"load lhs variable", id->literal);
-         if (node->tknClass == INC)
-         {
-            emitRM((char *)"LDA", 3, 1, 3, (char *)"increment value of", id->literal);
-         }
-         else
-         {
-            emitRM((char *)"LDA", 3, -1, 3, (char *)"decrement value of", id->literal);
-         }
-         emitRM((char *)"ST", 3, 0, 5, (char *)"Store variable", id->literal);
-      }
-   }
-}
-
-/* ==================================================
-   GENERATE 'AND' & 'OR
-   ================================================== */
-void generate_and_or(Node *node)
-{
-   Node *lhs = node->child[0];
-   Node *rhs = node->child[1];
-
-   // 1. Load LHS
-   if (load_in(lhs) == false)
-   {
-      if (load_arr_op(lhs) == false)
-      {
-         switch (lhs->nodeType)
-         {
-         case OpNT:
-            generate_op(lhs);
-            break;
-         case AndNT:
-            generate_and_or(lhs);
-            break;
-         case OrNT:
-            generate_and_or(lhs);
-            break;
-         case NotNT:
-            generate_not(lhs);
-            break;
-         case CallNT:
-            generate_call(lhs);
-            break;
-         }
-         emitRM((char *)"ST", 3, toffset, 1, (char *)"Push left side");
-      }
-      else
-      {
-         emitRM((char *)"ST", 3, toffset, 1, (char *)"Push left side");
-      }
-   }
-   else
-   {
-      emitRM((char *)"ST", 3, toffset, 1, (char *)"Push left side");
-   }
-   toffset -= 1;
-   emitComment((char *)"TOFF dec:", toffset);
-   // 2. Load RHS
-   if (load_in(rhs) == false)
-   {
-      if (load_arr_op(rhs) == false)
-      {
-         switch (rhs->nodeType)
-         {
-         case OpNT:
-            generate_op(rhs);
-            break;
-         case OrNT:
-            generate_and_or(rhs);
-            break;
-         case AndNT:
-            generate_and_or(rhs);
-            break;
-         case NotNT:
-            generate_not(rhs);
-            break;
-         case QuesNT:
-            generate_Ques(rhs);
-            break;
-         case CallNT:
-            generate_call(rhs);
-            break;
-         }
-      }
-   }
-   toffset += 1;
-   emitComment((char *)"TOFF inc:", toffset);
-   emitRM((char *)"LD", 4, toffset, 1, (char *)"Pop left into ac1");
-   switch (node->nodeType)
-   {
-   case OrNT:
-      emitRO((char *)"OR", 3, 4, 3, (char *)"Op OR");
-      break;
-   case AndNT:
-      emitRO((char *)"AND", 3, 4, 3, (char *)"Op AND");
-      break;
-   }
-}
-
-/* ==================================================
-   GENERATE NOT
-   ================================================== */
-void generate_not(Node *node)
-{
-   if (load_in(node->child[0]) == false)
-   {
-      switch (node->child[0]->nodeType)
-      {
-      case OpNT:
-         generate_op(node->child[0]);
-         break;
-      case CallNT:
-         generate_call(node->child[0]);
-         break;
-      case NotNT:
-         generate_not(node->child[0]);
-         break;
-      case ArrNT:
-         load_arr_op(node->child[0]);
-         break;
-      }
-   }
-   emitRM((char *)"LDC", 4, 1, 6, (char *)"Load 1");
-   emitRO((char *)"XOR", 3, 3, 4, (char *)"Op XOR to get logical not");
-}
-
-/* ==================================================
-   GENERATE IF
-   ================================================== */
-void generate_if(Node *node)
-{
-
-   Node *A = node->child[0];
-   Node *B = node->child[1];
-   Node *C = node->child[2];
-
-   if (C == NULL) // IF (A) THEN (B)
-   {
-      int rememberIf;
-      emitComment((char *)"IF");
-
-      switch (A->nodeType)
-      {
-      case ArrNT:
-         load_arr_op(A);
-         break;
-      case OpNT:
-         generate_op(A);
-         break;
-      default:
-         gc_traverse_sibs(A);
-         break;
-      }
-      rememberIf = emitSkip(1);
-      emitComment((char *)"THEN");
-      gc_traverse_sibs(B);
-      if (B->nodeType == BreakNT)
-      {
-         if (embedded_loop != NULL)
-         {
-            find_embedded_stmts(B, embedded_loop);
-         }
-         else if (loop != NULL)
-         {
-            find_embedded_stmts(B, loop);
-         }
-      }
-      int temp_emitLoc = emitWhereAmI();
-      emitNewLoc(rememberIf);
-      emitRM((char *)"JZR", 3, temp_emitLoc - rememberIf - 1, 7, (char *)"Jump around the THEN if false [backpatch]");
-      emitNewLoc(temp_emitLoc);
-      emitComment((char *)"END IF");
-   }
-   else // IF (A) THEN (B) ELSE (C)
-   {
-      int L1patch, L2patch;
-      emitComment((char *)"IF");
-      gc_traverse_sibs(A);
-      L1patch = emitSkip(1);
-      emitComment((char *)"THEN");
-      gc_traverse_sibs(B);
-      int temp_emitLoc = emitWhereAmI();
-      emitNewLoc(L1patch);
-      emitRM((char *)"JZR", 3, temp_emitLoc - L1patch, 7, (char *)"Jump around the THEN if false [backpatch]");
-      emitNewLoc(temp_emitLoc);
-      L2patch = emitSkip(1);
-      emitComment((char *)"ELSE");
-      // TEMP?
-      if (C->nodeType == OpNT)
-         emitComment((char *)"EXPRESSION");
-      gc_traverse_sibs(C);
-      temp_emitLoc = emitWhereAmI();
-      emitNewLoc(L2patch);
-      emitRM((char *)"JMP", 7, temp_emitLoc - L2patch - 1, 7, (char *)"Jump around the ELSE [backpatch]");
-      emitNewLoc(temp_emitLoc);
-      emitComment((char *)"END IF");
-   }
-}
-
-/* ==================================================
-   GENERATE WHILE
-   ================================================== */
-void generate_while(Node *node)
-{
-   loop = node;
-   Node *A = node->child[0];
-   Node *B = node->child[1];
-
-   /*
-      while (E) A
-
-      L1:                                 rememberL1 = emit(0)
-      t1 = E                              traverse(E)
-      if_false t1 goto L2    <- backpatch rememberbp = emit(1)
-      A                                   traverse(A)
-      goto L1                             jumpbackto(rememberL1)
-      L2:
-   */
-   int rememberL1 = emitSkip(0);
-   emitComment((char *)"WHILE");
-   gc_traverse_sibs(A);
-   emitRM((char *)"JNZ", 3, 1, 7, (char *)"Jump to while part");
-   int rememberbp = node->break_address = emitSkip(1);
-   emitComment((char *)"DO");
-   generate_while_compound(B, node);
-   emitRM((char *)"JMP", 7, rememberL1 - emitWhereAmI() - 1, 7, (char *)"go to beginning of loop");
-   int emitLoc = emitWhereAmI();
-   emitNewLoc(rememberbp);
-   emitRM((char *)"JMP", 7, emitLoc - rememberbp - 1, 7, (char *)"Jump past loop [backpatch]");
-   emitNewLoc(emitLoc);
-   emitComment((char *)"END WHILE");
-   loop = NULL;
-}
-
-/* ==================================================
-   GENERATE FOR
-   ================================================== */
-void generate_for(Node *node)
-{
-   loop = node;
-   Node *cdn = node->child[0];
-   Node *range = node->child[1];
-   Node *stmt = node->child[2];
-
-   int toffset_temp = toffset;
-   toffset = node->size;
-   emitComment((char *)"TOFF set:", toffset);
-   emitComment((char *)"FOR");
-   // 0. Insert cdm
-   gcST.insert(cdn->literal, cdn);
-   // 1. Load in Range
-   if (load_in(range->child[0]) == false)
-   {
-      switch (range->child[0]->nodeType)
-      {
-      case OpNT:
-         generate_op(range->child[0]);
-         break;
-      }
-   }
-   emitRM((char *)"ST", 3, toffset_temp, 1, (char *)"save starting value in index variable");
-   if (load_in(range->child[1]) == false)
-   {
-      switch (range->child[1]->nodeType)
-      {
-      case OpNT:
-         generate_op(range->child[1]);
-         break;
-      case SizeOfNT:
-         generate_sizeof(range->child[1]);
-         break;
-      }
-   }
-   emitRM((char *)"ST", 3, toffset_temp - 1, 1, (char *)"save stop value");
-   if (range->child[2] == NULL)
-   {
-      emitRM((char *)"LDC", 3, 1, 6, (char *)"default increment by 1");
-   }
-   else
-   {
-      if (load_in(range->child[2]) == false)
-      {
-         switch (range->child[2]->nodeType)
-         {
-         case SignNT:
-            generate_ChSign(range->child[2]);
-            break;
-         case OpNT:
-            generate_op(range->child[2]);
-            break;
-         }
-      }
-   }
-   // toffset = toffset_temp;
-   int L1 = emitWhereAmI();
-   toffset = toffset_temp;
-   emitRM((char *)"ST", 3, toffset - 2, 1, (char *)"save step value");
-   emitRM((char *)"LD", 4, toffset, 1, (char *)"loop index");
-   emitRM((char *)"LD", 5, toffset - 1, 1, (char *)"stop value");
-   emitRM((char *)"LD", 3, toffset - 2, 1, (char *)"step value");
-   emitRO((char *)"SLT", 3, 4, 5, (char *)"Op <");
-   emitRM((char *)"JNZ", 3, 1, 7, (char *)"Jump to loop body");
-   toffset = node->size;
-   int backpatch = emitSkip(1);
-   generate_for_compound(stmt, node);
-   emitComment((char *)"Bottom of loop increment and jump");
-   emitRM((char *)"LD", AC, toffset_temp, 1, (char *)"Load index");
-   emitRM((char *)"LD", AC2, toffset_temp - 2, 1, (char *)"Load step");
-   emitRO((char *)"ADD", 3, 3, 5, (char *)"increment");
-   emitRM((char *)"ST", 3, toffset_temp, 1, (char *)"store back to index");
-   emitRM((char *)"JMP", 7, L1 - emitWhereAmI(), 7, (char *)"go to beginning of loop");
-   // printf("l1 %d\n", L1);
-   // printf("toff %d\n", toffset);
-   // printf("temp toff %d\n", toffset_temp);
-   // printf("bp %d\n", backpatch);
-   // printf("RN %d\n", emitWhereAmI());
-   //  emitRM((char *)"JMP", 7, backpatch - emitWhereAmI() + toffset_temp - 1, 7, (char *)"go to beginning of loop");
-   int emitLoc = emitWhereAmI();
-   emitNewLoc(backpatch);
-   emitRM((char *)"JMP", 7, emitLoc - backpatch - 1, 7, (char *)"Jump past loop [backpatch]");
-   emitNewLoc(emitLoc);
-   emitComment((char *)"END LOOP");
-   toffset = toffset_temp;
-   if (node->sibling != NULL)
-   {
-      if (node->sibling->nodeType != ToNT)
-      {
-         toffset -= 3;
-      }
-   }
-   loop = NULL;
-}
-
-/* ==================================================
-   GENERATE EMBEDDED FOR LOOP
-   ================================================== */
-
-/* ==================================================
-   GENERATE RANGE
-   ================================================== */
-void generate_range(Node *node)
-{
-}
-
-/* ==================================================
-   GLOBAL CONSTANTS
-   ================================================== */
-void generate_constant(Node *node)
-{
-}
-
-/* ==================================================
-   GLOBAL CONSTANTS
-   ================================================== */
-void generate_id(Node *node)
-{
-}
-
-/* ==================================================
-   GENERATE CALL
-   ================================================== */
-void generate_call(Node *node)
-{
-   char msg[32];
-   int toffset_temp = toffset;
-   emitComment((char *)"CALL", node->literal);
-   emitRM((char *)"ST", 1, toffset, 1, (char *)"Store fp in ghost frame for", node->literal);
-   toffset -= 1;
-   emitComment((char *)"TOFF dec:", toffset);
-   toffset -= 1;
-   emitComment((char *)"TOFF dec:", toffset);
-
-   Node *parm = node->child[0];
-   if (parm != NULL)
-   {
-      int n = 1;
-      while (parm != NULL)
-      {
-         generate_passed_parms(parm, n);
-         emitRM((char *)"ST", 3, toffset, 1, (char *)"Push parameter");
-         toffset -= 1;
-         emitComment((char *)"TOFF dec:", toffset);
-         n++;
-         parm = parm->sibling;
-         if (parm == NULL)
-         {
-            emitComment((char *)"Param end", node->literal);
-         }
-      }
-   }
-   else
-   {
-      emitComment((char *)"Param end", node->literal);
-   }
-   toffset = toffset_temp;
-   emitRM((char *)"LDA", 1, toffset, 1, (char *)"Ghost frame becomes new active frame");
-   emitRM((char *)"LDA", 3, 1, 7, (char *)"Return address in ac");
-
-   Node *call_sym = fetchSymbol(node, &gcST);
-   emitRM((char *)"JMP", 7, call_sym->address - emitWhereAmI() - 1, 7, (char *)"CALL", node->literal);
-   emitRM((char *)"LDA", 3, 0, 2, (char *)"Save the result in ac");
-   emitComment((char *)"Call end", node->literal);
-   emitComment((char *)"TOFF set:", toffset);
-}
-
-/* ==================================================
-   GENERATE PARAMETERS
-   ================================================== */
-void generate_passed_parms(Node *node, int c)
-{
-   emitComment((char *)"Param", c);
-   if (load_in(node) == false)
-   {
-      // Handle other nodetypes...
-      switch (node->nodeType)
-      {
-      case AssignNT:
-         generate_assignment(node);
-         break;
-      case OpNT:
-         generate_op(node);
-         break;
-      case AndNT:
-         generate_and_or(node);
-         break;
-      case OrNT:
-         generate_and_or(node);
-         break;
-      case SignNT:
-         generate_ChSign(node);
-         break;
-      case NotNT:
-         generate_not(node);
-         break;
-      case QuesNT:
-         generate_Ques(node);
-         break;
-      case ArrNT:
-         load_arr_op(node);
-         break;
-      case CallNT:
-         generate_call(node);
-         break;
-      case SizeOfNT:
-         generate_sizeof(node);
-         break;
-      }
-   }
-   if (node->nodeType == StringConstNT)
-   {
-      emitStrLit(string_offset, node->data.String);
-      string_offset -= node->size;
-      emitRM((char *)"LDA", 3, node->location, node->refType, (char *)"Load address of char array");
-   }
-}
-
-/* ==================================================
-   GENERATE RETURN
-   ================================================== */
-void generate_return(Node *node)
-{
-   emitComment((char *)"RETURN");
-   if (current_function->hasReturn)
-   {
-      if (load_in(node->child[0]) == false)
-      {
-         if (load_arr_op(node->child[0]) == false)
-         {
-            switch (node->child[0]->nodeType)
-            {
-            case OpNT:
-               generate_op(node->child[0]);
-               break;
-            case ArrNT:
-               load_arr_op(node->child[0]);
-               break;
-            case CallNT:
-               generate_call(node->child[0]);
-               break;
-            case SizeOfNT:
-               generate_sizeof(node->child[0]);
-               break;
-            case AndNT:
-               generate_and_or(node->child[0]);
-               break;
-            }
-            emitRM((char *)"LDA", 2, 0, 3, (char *)"Copy result to return register");
-         }
-         else
-         {
-            emitRM((char *)"LDA", 2, 0, 3, (char *)"Copy result to return register");
-         }
-      }
-      else
-      {
-         emitRM((char *)"LDA", 2, 0, 3, (char *)"Copy result to return register");
-      }
-   }
-   emitRM((char *)"LD", 3, -1, 1, (char *)"Load return address");
-   emitRM((char *)"LD", 1, 0, 1, (char *)"Adjust fp");
-   emitRM((char *)"JMP", 7, 0, 3, (char *)"Return");
-}
-
-/* ==================================================
-   GENERATE QUESNT
-   ================================================== */
-void generate_Ques(Node *node)
-{
-   load_in(node->child[0]);
-   emitRO((char *)"RND", 3, 3, 6, (char *)"Op ?");
-}
-
-/* ==================================================
-   GENERATE CHSIGNNT
-   ================================================== */
-void generate_ChSign(Node *node)
-{
-   if (load_in(node->child[0]) == false)
-   {
-      switch (node->child[0]->nodeType)
-      {
-      case OpNT:
-         generate_op(node->child[0]);
-         break;
-      case SignNT:
-         generate_ChSign(node->child[0]);
-         break;
-      }
-   }
-   emitRO((char *)"NEG", 3, 3, 3, (char *)"Op unary -");
-}
-/* ==================================================
-   GENERATE CHSIGNNT
-   ================================================== */
-void generate_sizeof(Node *node)
-{
-   Node *arr = fetchSymbol(node->child[0], &gcST);
-
-   if (arr->nodeType == ParmArrNT)
-   {
-      emitRM((char *)"LD", AC, arr->location, arr->refType, (char *)"Load address of base of array", arr->literal);
-   }
-   else if (arr->nodeType == VarArrNT)
-   {
-      if (arr->dataType == CharDT)
-      {
-         if (arr->refType == GlobalRT && arr->nodeType == ParmArrNT)
-         {
-            emitRM((char *)"LDA", AC, arr->location, arr->refType, (char *)"Load address of base of array", arr->literal);
-         }
-         else
-         {
-            emitRM((char *)"LD", AC, arr->location, arr->refType, (char *)"Load address of base of array", arr->literal);
-         }
-      }
-      else
-      {
-         emitRM((char *)"LDA", AC, arr->location, arr->refType, (char *)"Load address of base of array", arr->literal);
-      }
-   }
-   else
-   {
-      emitRM((char *)"LDA", AC, arr->location, arr->refType, (char *)"Load address of base of array", arr->literal);
-   }
-   emitRM((char *)"LD", 3, 1, 3, (char *)"Load array size");
-}
-
-void generate_string(Node *node)
-{
-   if (node->nodeType == StringConstNT && curr_decl != NULL)
-   {
-      emitStrLit(string_offset, node->data.String);
-      string_offset -= node->size;
-      emitRM((char *)"LDA", 3, node->location, node->refType, (char *)"Load address of char array");
-      emitRM((char *)"LDA", 4, curr_decl->location, curr_decl->refType, (char *)"address of lhs");
-      emitRM((char *)"LD", 5, 1, 3, (char *)"size of rhs");
-      emitRM((char *)"LD", 6, 1, 4, (char *)"size of lhs");
-      emitRO((char *)"SWP", 5, 6, 6, (char *)"pick smallest size");
-      emitRO((char *)"MOV", 4, 3, 5, (char *)"array op =");
-   }
+#include "code_gen.hpp"
+#include "profile.hpp"
+#include "optimize.hpp"
+#include "pass_manager.hpp"
+#include <limits.h>
+#include <string.h>
+
+extern FILE *code;
+extern int goffset;
+
+extern SymbolTable gcST;
+extern int toffset;
+extern int address_of_main;
+extern Node *curr_decl;
+
+extern bool in_loop;
+extern Node *loop;
+extern Node *embedded_loop;
+extern int unroll_flag;
+extern int regloop_flag;
+extern int rotate_flag;
+extern int simplify_flag;
+extern int jumptable_flag;
+extern int idiom_flag;
+extern int inline_io_flag;
+
+Node *current_function = NULL;
+int string_offset = -1;
+
+/* ==================================================
+   GENERATE FUNCTION
+   ================================================== */
+void generate_function(Node *func)
+{
+   gcST.insert(func->literal, func);
+   gcST.enter(func->literal);
+   current_function = func;
+   int toffset_temp = toffset;
+   toffset = func->size;
+   func->address = emitWhereAmI();
+   emitSource(func->lineNum, func->literal);
+   profile_site("func", func, NULL);
+   if (func->isMain)
+   {
+      address_of_main = func->address;
+   }
+   emitComment((char *)"** ** ** ** ** ** ** ** ** ** ** **");
+   emitComment((char *)"FUNCTION", func->literal);
+   emitComment((char *)"TOFF set:", toffset);
+   emitRM((char *)"ST", 3, -1, 1, (char *)"Store return address");
+   gc_traverse_children(func);
+   emitComment((char *)"Add standard closing in case there is no return statement");
+   emitRM((char *)"LDC", 2, 0, 6, (char *)"Set return value to 0");
+   emitRM((char *)"LD", 3, -1, 1, (char *)"Load return address");
+   emitRM((char *)"LD", 1, 0, 1, (char *)"Adjust fp");
+   emitRM((char *)"JMP", 7, 0, 3, (char *)"Return");
+   toffset = toffset_temp;
+   emitSource(0, NULL);
+   emitComment((char *)"END FUNCTION", func->literal);
+   if (!func->isMain)
+   {
+      emitComment((char *)"");
+   }
+   gcST.leave();
+}
+
+/* ==================================================
+   GENERATE FUNCTION COMPOUND
+   ================================================== */
+void generate_function_compound(Node *node)
+{
+   int toffset_temp = toffset;
+   toffset = node->size;
+   emitComment((char *)"COMPOUND");
+   emitComment((char *)"TOFF set:", toffset);
+   gc_traverse_sibs(node->child[0]); // Declarations
+   emitComment((char *)"Compound Body");
+   gc_traverse_children(node);
+   toffset = toffset_temp;
+   emitComment((char *)"TOFF set:", toffset);
+   emitComment((char *)"END COMPOUND");
+}
+
+/* ==================================================
+   GENERATE FUNCTION COMPOUND
+   ================================================== */
+void generate_compound(Node *node)
+{
+   gcST.enter("Compound");
+   int toffset_temp = toffset;
+   toffset = temp_start(node->size);
+   emitComment((char *)"COMPOUND");
+   emitComment((char *)"TOFF set:", toffset);
+   gc_traverse_sibs(node->child[0]); // Declarations
+   emitComment((char *)"Compound Body");
+   gc_traverse_children(node);
+   toffset = toffset_temp;
+   emitComment((char *)"TOFF set:", toffset);
+   emitComment((char *)"END COMPOUND");
+   gcST.leave();
+}
+
+/* ==================================================
+   GENERATE OPERATORS
+   ================================================== */
+// AC <- left op right
+static void emit_op(int tknClass, int left, int right)
+{
+   switch (tknClass)
+   {
+   case MUL:
+      emitRO((char *)"MUL", 3, left, right, (char *)"Op *");
+      break;
+   case ADD:
+      emitRO((char *)"ADD", 3, left, right, (char *)"Op +");
+      break;
+   case SUB:
+      emitRO((char *)"SUB", 3, left, right, (char *)"Op -");
+      break;
+   case DIV:
+      emitRO((char *)"DIV", 3, left, right, (char *)"Op /");
+      break;
+   case MOD:
+      emitRO((char *)"MOD", 3, left, right, (char *)"Op %");
+      break;
+   case EQL:
+      emitRO((char *)"TEQ", 3, left, right, (char *)"Op =");
+      break;
+   case GREAT:
+      emitRO((char *)"TGT", 3, left, right, (char *)"Op >");
+      break;
+   case LESS:
+      emitRO((char *)"TLT", 3, left, right, (char *)"Op <");
+      break;
+   case LEQ:
+      emitRO((char *)"TLE", 3, left, right, (char *)"Op <=");
+      break;
+   case GEQ:
+      emitRO((char *)"TGE", 3, left, right, (char *)"Op >=");
+      break;
+   case NEQ:
+      emitRO((char *)"TNE", 3, left, right, (char *)"Op ><");
+      break;
+   }
+}
+
+// Loads an operand of a binary operator into AC.
+static void load_operand(Node *node)
+{
+   if (load_in(node) || load_arr_op(node))
+      return;
+   switch (node->nodeType)
+   {
+   case OpNT:
+      generate_op(node);
+      break;
+   case QuesNT:
+      generate_Ques(node);
+      break;
+   case SignNT:
+      generate_ChSign(node);
+      break;
+   case CallNT:
+      generate_call(node);
+      break;
+   case AssignNT:
+      generate_assignment(node);
+      break;
+   case SizeOfNT:
+      generate_sizeof(node);
+      break;
+   }
+}
+
+// An operator with one constant operand (-fsimplify) computes the other
+// operand into AC and loads the constant into AC1, without a push and pop.
+// Multiplying by 2 or 4 doubles AC instead, and by -1 negates it.
+static bool generate_const_op(Node *node)
+{
+   Node *lhs = node->child[0];
+   Node *rhs = node->child[1];
+   int l, r;
+   if (!simplify_flag || lhs->isArray || rhs->isArray)
+      return false;
+   bool lc = eval_const(lhs, &l);
+   bool rc = eval_const(rhs, &r);
+   if (lc == rc)
+      return false;
+   bool constLeft = lc;
+   int value = lc ? l : r;
+   Node *var = constLeft ? rhs : lhs;
+   // Register operands are used in place already.
+   if (operand_reg(var) >= 0)
+      return false;
+
+   load_operand(var);
+   count_changes(PASS_SIMPLIFY, 1);
+   if (node->tknClass == MUL && (value == 2 || value == 4))
+   {
+      for (int n = value; n > 1; n /= 2)
+         emitRO((char *)"ADD", 3, 3, 3, (char *)"Op * (double)");
+      return true;
+   }
+   if (node->tknClass == MUL && value == -1)
+   {
+      emitRO((char *)"NEG", 3, 3, 3, (char *)"Op * (negate)");
+      return true;
+   }
+   emitRM((char *)"LDC", AC1, value, 6, (char *)"Load constant operand");
+   if (constLeft)
+      emit_op(node->tknClass, AC1, AC);
+   else
+      emit_op(node->tknClass, AC, AC1);
+   return true;
+}
+
+void generate_op(Node *node)
+{
+   Node *lhs = node->child[0];
+   Node *rhs = node->child[1];
+
+   if (generate_const_op(node))
+      return;
+
+   // Operands held in registers are used in place.
+   int left = AC1;
+   int right = AC;
+   int lreg = operand_reg(lhs);
+   int rreg = operand_reg(rhs);
+   bool pushed = false;
+
+   // 1. Load LHS
+   if (lreg >= 0 && count_writes(rhs, lhs->literal) == 0)
+   {
+      left = lreg;
+   }
+   else
+   {
+      // If LHS is not a constant, variable or array...
+      if (load_in(lhs) == false && load_arr_op(lhs) == false)
+      {
+         // For any other nodetypes...
+         switch (lhs->nodeType)
+         {
+         case OpNT:
+            generate_op(lhs);
+            break;
+         case QuesNT:
+            generate_Ques(lhs);
+            break;
+         case SignNT:
+            generate_ChSign(lhs);
+            break;
+         case CallNT:
+            generate_call(lhs);
+            break;
+         case AssignNT:
+            generate_assignment(lhs);
+            break;
+         case SizeOfNT:
+            generate_sizeof(lhs);
+            break;
+         }
+      }
+      if (rreg >= 0)
+      {
+         left = AC;
+      }
+      else
+      {
+         emitRM((char *)"ST", 3, toffset, 1, (char *)"Push left side");
+         toffset -= 1;
+         emitComment((char *)"TOFF dec:", toffset);
+         pushed = true;
+      }
+   }
+   // 2. Load RHS
+   if (rreg >= 0)
+   {
+      right = rreg;
+   }
+   else if (load_in(rhs) == false)
+   {
+      // If RHS is an array...
+      if (load_arr_op(rhs) == false)
+      {
+         // For any other nodetypes...
+         switch (rhs->nodeType)
+         {
+         case OpNT:
+            generate_op(rhs);
+            break;
+         case QuesNT:
+            generate_Ques(rhs);
+            break;
+         case SignNT:
+            generate_ChSign(rhs);
+            break;
+         case CallNT:
+            generate_call(rhs);
+            break;
+         case SizeOfNT:
+            generate_sizeof(rhs);
+            break;
+         }
+      }
+   }
+   if (pushed)
+   {
+      toffset += 1;
+      emitComment((char *)"TOFF inc:", toffset);
+      emitRM((char *)"LD", 4, toffset, 1, (char *)"Pop left into ac1");
+   }
+   if (rhs->isArray && rhs->dataType == CharDT)
+   {
+      spill_loop_regs();
+      emitRM((char *)"LD", AC2, 1, 3, (char *)"AC2 <- |RHS|");
+      emitRM((char *)"LD", AC3, 1, 4, (char *)"AC3 <- |LHS|");
+      emitRM((char *)"LDA", 2, 0, 5, (char *)"R2 <- |RHS|");
+      emitRO((char *)"SWP", 5, 6, 6, (char *)"pick smallest size");
+      emitRM((char *)"LD", AC3, 1, 4, (char *)"AC3 <- |LHS|");
+      emitRO((char *)"CO", 4, 3, 5, (char *)"setup array compare  LHS vs RHS");
+      emitRO((char *)"TNE", 5, AC1, AC, (char *)"if not equal then test (AC1, AC)");
+      emitRO((char *)"JNZ", 5, 2, 7, (char *)"jump not equal");
+      emitRM((char *)"LDA", AC, 0, 2, (char *)"AC1 <- |RHS|");
+      emitRM((char *)"LDA", AC1, 0, 6, (char *)"AC <- |LHS|");
+      reload_loop_regs();
+   }
+   emit_op(node->tknClass, left, right);
+}
+
+/* ==================================================
+   GENERATE ASSIGNMENTS
+   ================================================== */
+void generate_assignment(Node *node)
+{
+   Node *lhs = node->child[0];
+   Node *rhs = node->child[1];
+
+   if (node->tknClass == ASGN)
+   {
+      // Check if LHS is an Array
+      if (load_arr_assign(lhs, rhs) == false)
+      {
+         // 1. Check RHS
+         if (load_in(rhs) == false)
+         {
+            switch (rhs->nodeType)
+            {
+            case AssignNT:
+               generate_assignment(rhs);
+               break;
+            case OpNT:
+               generate_op(rhs);
+               break;
+            case CallNT:
+               generate_call(rhs);
+               break;
+            case AndNT:
+               generate_and_or(rhs);
+               break;
+            case OrNT:
+               generate_and_or(rhs);
+               break;
+            case NotNT:
+               generate_not(rhs);
+               break;
+            case SignNT:
+               generate_ChSign(rhs);
+               break;
+            case ArrNT:
+               load_arr_op(rhs);
+               break;
+            }
+         }
+         // 2. Store LHS
+         if (rhs->isArray && rhs->nodeType == IdNT)
+         {
+            spill_loop_regs();
+            emitRM((char *)"LDA", 4, lhs->location, 1, (char *)"address of lhs");
+            emitRM((char *)"LD", 5, 1, 3, (char *)"size of rhs");
+            emitRM((char *)"LD", 6, 1, 4, (char *)"size of lhs");
+            emitRO((char *)"SWP", 5, 6, 6, (char *)"pick smallest size");
+            emitRO((char *)"MOV", 4, 3, 5, (char *)"array op =");
+            reload_loop_regs();
+         }
+         else
+         {
+            store_var(lhs);
+         }
+      }
+      else
+      {
+         emitRM((char *)"ST", 3, 0, 5, (char *)"Store variable", lhs->child[0]->literal);
+      }
+   }
+   else if (node->tknClass == ADDASS || node->tknClass == SUBASS ||
+            node->tknClass == MULASS || node->tknClass == DIVASS)
+   {
+      char *cmd = NULL;
+      char *out_msg = NULL;
+
+      switch (node->tknClass)
+      {
+      case ADDASS:
+         cmd = (char *)"ADD\0";
+         out_msg = (char *)"op +=\0";
+         break;
+      case SUBASS:
+         cmd = (char *)"SUB\0";
+         out_msg = (char *)"op -=\0";
+         break;
+      case MULASS:
+         cmd = (char *)"MUL\0";
+         out_msg = (char *)"op *=\0";
+         break;
+      case DIVASS:
+         cmd = (char *)"DIV\0";
+         out_msg = (char *)"op /=\0";
+         break;
+      }
+
+      // Check if LHS is an Array
+      if (load_arr_assign(lhs, rhs) == false)
+      {
+         // 1. Check RHS
+         if (load_in(rhs) == false)
+         {
+            switch (rhs->nodeType)
+            {
+            case AssignNT:
+               generate_assignment(rhs);
+               break;
+            case ArrNT:
+               load_arr_op(rhs);
+               break;
+            case OpNT:
+               generate_op(rhs);
+               break;
+            }
+         }
+         Node *sym = fetchSymbol(lhs, &gcST);
+         // A variable held in a register is read from there.
+         int reg = var_reg(sym);
+         if (reg < 0)
+         {
+            emitRM((char *)"LD", 4, sym->location, sym->refType, (char *)"load lhs variable", sym->literal);
+            reg = 4;
+         }
+         emitRO(cmd, 3, reg, 3, out_msg);
+         if (lhs->nodeType == ArrNT)
+            emitRM((char *)"ST", 3, sym->location, sym->refType, (char *)"Store variable", sym->literal);
+         //  2. Store LHS
+         store_var(lhs);
+      }
+      else
+      {
+         Node *sym = fetchSymbol(lhs->child[0], &gcST);
+         emitRM((char *)"LD", 4, 0, 5, (char *)"load lhs variable", sym->literal);
+         emitRO(cmd, 3, 4, 3, out_msg);
+         if (lhs->nodeType == ArrNT)
+            emitRM((char *)"ST", 3, 0, 5, (char *)"Store variable", sym->literal);
+      }
+   }
+   else if (node->tknClass == INC || node->tknClass == DEC)
+   {
+      Node *val = node->child[0];
+      if (val->nodeType == IdNT)
+      {
+         Node *id = fetchSymbol(val, &gcST);
+         // A variable held in a register is stepped from there.
+         int reg = var_reg(id);
+         if (reg < 0)
+         {
+            emitRM((char *)"LD", 3, id->location, id->refType, (char *)"load lhs variable", id->literal);
+            reg = 3;
+         }
+         if (node->tknClass == INC)
+         {
+            emitRM((char *)"LDA", 3, 1, reg, (char *)"increment value of", val->literal);
+         }
+         else
+         {
+            emitRM((char *)"LDA", 3, -1, reg, (char *)"decrement value of", val->literal);
+         }
+         store_var(val);
+      }
+      else if (val->nodeType == ArrNT)
+      {
+         Node *id = fetchSymbol(val->child[0], &gcST);
+         Node *idx = val->child[1];
+         load_in(idx);
+         if (id->nodeType == ParmArrNT)
+         {
+            emitRM((char *)"LD", AC2, id->location, id->refType, (char *)"Load address of base of array", id->literal);
+         }
+         else
+         {
+            emitRM((char *)"LDA", AC2, id->location, id->refType, (char *)"Load address of base of array", id->literal);
+         }
+         emitRO((char *)"SUB", 5, 5, 3, (char *)"Compute offset of value");
+         emitRM((char *)"LD", 3, 0, 5, (char *)"load lhs variable", id->literal);
+         if (node->tknClass == INC)
+         {
+            emitRM((char *)"LDA", 3, 1, 3, (char *)"increment value of", id->literal);
+         }
+         else
+         {
+            emitRM((char *)"LDA", 3, -1, 3, (char *)"decrement value of", id->literal);
+         }
+         emitRM((char *)"ST", 3, 0, 5, (char *)"Store variable", id->literal);
+      }
+   }
+}
+
+/* ==================================================
+   GENERATE 'AND' & 'OR
+   ================================================== */
+void generate_and_or(Node *node)
+{
+   Node *lhs = node->child[0];
+   Node *rhs = node->child[1];
+
+   // 1. Load LHS
+   if (load_in(lhs) == false)
+   {
+      if (load_arr_op(lhs) == false)
+      {
+         switch (lhs->nodeType)
+         {
+         case OpNT:
+            generate_op(lhs);
+            break;
+         case AndNT:
+            generate_and_or(lhs);
+            break;
+         case OrNT:
+            generate_and_or(lhs);
+            break;
+         case NotNT:
+            generate_not(lhs);
+            break;
+         case CallNT:
+            generate_call(lhs);
+            break;
+         }
+         emitRM((char *)"ST", 3, toffset, 1, (char *)"Push left side");
+      }
+      else
+      {
+         emitRM((char *)"ST", 3, toffset, 1, (char *)"Push left side");
+      }
+   }
+   else
+   {
+      emitRM((char *)"ST", 3, toffset, 1, (char *)"Push left side");
+   }
+   toffset -= 1;
+   emitComment((char *)"TOFF dec:", toffset);
+   // 2. Load RHS
+   if (load_in(rhs) == false)
+   {
+      if (load_arr_op(rhs) == false)
+      {
+         switch (rhs->nodeType)
+         {
+         case OpNT:
+            generate_op(rhs);
+            break;
+         case OrNT:
+            generate_and_or(rhs);
+            break;
+         case AndNT:
+            generate_and_or(rhs);
+            break;
+         case NotNT:
+            generate_not(rhs);
+            break;
+         case QuesNT:
+            generate_Ques(rhs);
+            break;
+         case CallNT:
+            generate_call(rhs);
+            break;
+         }
+      }
+   }
+   toffset += 1;
+   emitComment((char *)"TOFF inc:", toffset);
+   emitRM((char *)"LD", 4, toffset, 1, (char *)"Pop left into ac1");
+   switch (node->nodeType)
+   {
+   case OrNT:
+      emitRO((char *)"OR", 3, 4, 3, (char *)"Op OR");
+      break;
+   case AndNT:
+      emitRO((char *)"AND", 3, 4, 3, (char *)"Op AND");
+      break;
+   }
+}
+
+/* ==================================================
+   GENERATE NOT
+   ================================================== */
+void generate_not(Node *node)
+{
+   if (load_in(node->child[0]) == false)
+   {
+      switch (node->child[0]->nodeType)
+      {
+      case OpNT:
+         generate_op(node->child[0]);
+         break;
+      case CallNT:
+         generate_call(node->child[0]);
+         break;
+      case NotNT:
+         generate_not(node->child[0]);
+         break;
+      case ArrNT:
+         load_arr_op(node->child[0]);
+         break;
+      }
+   }
+   emitRM((char *)"LDC", 4, 1, 6, (char *)"Load 1");
+   emitRO((char *)"XOR", 3, 3, 4, (char *)"Op XOR to get logical not");
+}
+
+/* ==================================================
+   GENERATE JUMP TABLE
+   ================================================== */
+// An if/else-if chain that tests one pure expression against integer
+// constants (-fjumptable)
+//    if E = c1 then S1 else if E = c2 then S2 ... else D
+// becomes a clamp of E into the table and a jump through a table of JMPs,
+// one per value in [lo, hi] and a default entry at both ends:
+//    AC <- E - lo + 1, clamped to [0, hi - lo + 2] with SWP
+//    ADD 7,3,7                     jump to entry AC
+//    JMP D, JMP S(lo) ... JMP S(hi), JMP D
+// The CFG pass finds the table size in the "LDC 4,n(6)" before the last SWP.
+#define JT_MIN_CASES 4   // Shorter chains stay compare-and-branch.
+#define JT_MAX_SPREAD 4  // Table entries allowed per case.
+#define JT_MAX_SIZE 256  // Largest table.
+
+struct JumpCase
+{
+   Node *ifNode;
+   int value;
+};
+
+// Is cond "E = c" (or "c = E") with E pure? Sets E and c.
+static bool case_test(Node *cond, Node **subject, int *value)
+{
+   if (cond == NULL || cond->nodeType != OpNT || cond->tknClass != EQL)
+      return false;
+   Node *lhs = cond->child[0];
+   Node *rhs = cond->child[1];
+   if (lhs->isArray || rhs->isArray)
+      return false;
+   int v;
+   if (eval_const(rhs, value) && !eval_const(lhs, &v))
+      *subject = lhs;
+   else if (eval_const(lhs, value) && !eval_const(rhs, &v))
+      *subject = rhs;
+   else
+      return false;
+   return is_pure(*subject);
+}
+
+static bool generate_jump_table(Node *node)
+{
+   Node *subject = NULL;
+   vector<JumpCase> cases;
+   Node *deflt = node;
+   Node *last = NULL;
+   while (deflt != NULL && deflt->nodeType == IfNT && (deflt == node || deflt->sibling == NULL))
+   {
+      Node *e;
+      JumpCase c;
+      if (!case_test(deflt->child[0], &e, &c.value) || (subject != NULL && !same_expr(e, subject)))
+         break;
+      subject = e;
+      c.ifNode = last = deflt;
+      cases.push_back(c);
+      deflt = deflt->child[2];
+   }
+   if ((int)cases.size() < JT_MIN_CASES)
+      return false;
+   long long lo = cases[0].value, hi = cases[0].value;
+   for (size_t i = 0; i < cases.size(); i++)
+   {
+      lo = min(lo, (long long)cases[i].value);
+      hi = max(hi, (long long)cases[i].value);
+   }
+   long long span = hi - lo + 1;
+   if (span > JT_MAX_SIZE || span > JT_MAX_SPREAD * (long long)cases.size())
+      return false;
+   // The offset 1 - lo of the LDA below is an int (lo near INT_MIN is not).
+   if (1 - lo > INT_MAX)
+      return false;
+   count_changes(PASS_JUMPTABLE, 1);
+
+   emitComment((char *)"IF (jump table)");
+   load_operand(subject);
+   if (lo != 1)
+      emitRM((char *)"LDA", AC, 1 - lo, AC, (char *)"Table entry of the value");
+   emitRM((char *)"LDC", AC1, 0, 6, (char *)"Entry below the cases");
+   emitRO((char *)"SWP", AC1, AC, AC, (char *)"AC <- max(AC, 0)");
+   emitRM((char *)"LDC", AC1, span + 1, 6, (char *)"Entry above the cases");
+   emitRO((char *)"SWP", AC, AC1, AC1, (char *)"AC <- min(AC, entries - 1)");
+   emitRO((char *)"ADD", PC, AC, PC, (char *)"Jump into the table");
+   int table = emitSkip(span + 2);
+
+   // Bodies in chain order; a repeated value is never taken.
+   vector<int> entry(span, -1);
+   vector<int> ends;
+   for (size_t i = 0; i < cases.size(); i++)
+   {
+      if (entry[cases[i].value - lo] >= 0)
+         continue;
+      entry[cases[i].value - lo] = emitWhereAmI();
+      emitComment((char *)"THEN");
+      profile_site("then", cases[i].ifNode, NULL);
+      coverage_probe("then", cases[i].ifNode);
+      gc_traverse_sibs(cases[i].ifNode->child[1]);
+      ends.push_back(emitSkip(1));
+   }
+   int deflt_addr = emitWhereAmI();
+   if (deflt != NULL)
+   {
+      emitComment((char *)"ELSE");
+      profile_site("else", last, NULL);
+      coverage_probe("else", last);
+      gc_traverse_sibs(deflt);
+   }
+   int end = emitWhereAmI();
+   for (size_t i = 0; i < ends.size(); i++)
+   {
+      emitNewLoc(ends[i]);
+      emitRM((char *)"JMP", 7, end - ends[i] - 1, 7, (char *)"Jump past the cases [backpatch]");
+   }
+   for (int k = 0; k < span + 2; k++)
+   {
+      int to = k == 0 || k == span + 1 || entry[k - 1] < 0 ? deflt_addr : entry[k - 1];
+      emitNewLoc(table + k);
+      emitRM((char *)"JMP", 7, to - (table + k) - 1, 7, (char *)"Jump table entry [backpatch]");
+   }
+   emitNewLoc(end);
+   emitComment((char *)"END IF");
+   return true;
+}
+
+/* ==================================================
+   GENERATE IF
+   ================================================== */
+void generate_if(Node *node)
+{
+
+   Node *A = node->child[0];
+   Node *B = node->child[1];
+   Node *C = node->child[2];
+
+   if (jumptable_flag && generate_jump_table(node))
+      return;
+
+   if (C == NULL) // IF (A) THEN (B)
+   {
+      int rememberIf;
+      emitComment((char *)"IF");
+
+      switch (A->nodeType)
+      {
+      case ArrNT:
+         load_arr_op(A);
+         break;
+      case OpNT:
+         generate_op(A);
+         break;
+      default:
+         gc_traverse_sibs(A);
+         break;
+      }
+      rememberIf = emitSkip(1);
+      emitComment((char *)"THEN");
+      profile_site("then", node, NULL);
+      coverage_probe("then", node);
+      gc_traverse_sibs(B);
+      if (B->nodeType == BreakNT)
+      {
+         if (embedded_loop != NULL)
+         {
+            find_embedded_stmts(B, embedded_loop);
+         }
+         else if (loop != NULL)
+         {
+            find_embedded_stmts(B, loop);
+         }
+      }
+      int temp_emitLoc = emitWhereAmI();
+      emitNewLoc(rememberIf);
+      emitRM((char *)"JZR", 3, temp_emitLoc - rememberIf - 1, 7, (char *)"Jump around the THEN if false [backpatch]");
+      emitNewLoc(temp_emitLoc);
+      emitComment((char *)"END IF");
+   }
+   else if (profile_hot_then(node)) // IF (A) ELSE (C) THEN (B), hot THEN last
+   {
+      int L1patch, L2patch;
+      emitComment((char *)"IF");
+      gc_traverse_sibs(A);
+      L1patch = emitSkip(1);
+      emitComment((char *)"ELSE");
+      profile_site("else", node, NULL);
+      coverage_probe("else", node);
+      if (C->nodeType == OpNT)
+         emitComment((char *)"EXPRESSION");
+      gc_traverse_sibs(C);
+      int temp_emitLoc = emitWhereAmI();
+      emitNewLoc(L1patch);
+      emitRM((char *)"JNZ", 3, temp_emitLoc - L1patch, 7, (char *)"Jump to the THEN if true [backpatch]");
+      emitNewLoc(temp_emitLoc);
+      L2patch = emitSkip(1);
+      emitComment((char *)"THEN");
+      profile_site("then", node, NULL);
+      coverage_probe("then", node);
+      gc_traverse_sibs(B);
+      temp_emitLoc = emitWhereAmI();
+      emitNewLoc(L2patch);
+      emitRM((char *)"JMP", 7, temp_emitLoc - L2patch - 1, 7, (char *)"Jump around the THEN [backpatch]");
+      emitNewLoc(temp_emitLoc);
+      emitComment((char *)"END IF");
+   }
+   else // IF (A) THEN (B) ELSE (C)
+   {
+      int L1patch, L2patch;
+      emitComment((char *)"IF");
+      gc_traverse_sibs(A);
+      L1patch = emitSkip(1);
+      emitComment((char *)"THEN");
+      profile_site("then", node, NULL);
+      coverage_probe("then", node);
+      gc_traverse_sibs(B);
+      int temp_emitLoc = emitWhereAmI();
+      emitNewLoc(L1patch);
+      emitRM((char *)"JZR", 3, temp_emitLoc - L1patch, 7, (char *)"Jump around the THEN if false [backpatch]");
+      emitNewLoc(temp_emitLoc);
+      L2patch = emitSkip(1);
+      emitComment((char *)"ELSE");
+      profile_site("else", node, NULL);
+      coverage_probe("else", node);
+      // TEMP?
+      if (C->nodeType == OpNT)
+         emitComment((char *)"EXPRESSION");
+      gc_traverse_sibs(C);
+      temp_emitLoc = emitWhereAmI();
+      emitNewLoc(L2patch);
+      emitRM((char *)"JMP", 7, temp_emitLoc - L2patch - 1, 7, (char *)"Jump around the ELSE [backpatch]");
+      emitNewLoc(temp_emitLoc);
+      emitComment((char *)"END IF");
+   }
+}
+
+/* ==================================================
+   GENERATE WHILE
+   ================================================== */
+void generate_while(Node *node)
+{
+   loop = node;
+   Node *A = node->child[0];
+   Node *B = node->child[1];
+
+   /*
+      while (E) A
+
+      L1:                                 rememberL1 = emit(0)
+      t1 = E                              traverse(E)
+      if_false t1 goto L2    <- backpatch rememberbp = emit(1)
+      A                                   traverse(A)
+      goto L1                             jumpbackto(rememberL1)
+      L2:
+   */
+   if ((idiom_flag && generate_bulk_while(node)) || (unroll_flag && generate_unrolled_while(node)) ||
+       (rotate_flag && generate_rotated_while(node)))
+   {
+      loop = NULL;
+      return;
+   }
+   int rememberL1 = emitSkip(0);
+   emitComment((char *)"WHILE");
+   gc_traverse_sibs(A);
+   emitRM((char *)"JNZ", 3, 1, 7, (char *)"Jump to while part");
+   coverage_probe("exit", node);
+   int rememberbp = node->break_address = emitSkip(1);
+   emitComment((char *)"DO");
+   generate_while_compound(B, node);
+   emitRM((char *)"JMP", 7, rememberL1 - emitWhereAmI() - 1, 7, (char *)"go to beginning of loop");
+   int emitLoc = emitWhereAmI();
+   emitNewLoc(rememberbp);
+   emitRM((char *)"JMP", 7, emitLoc - rememberbp - 1, 7, (char *)"Jump past loop [backpatch]");
+   emitNewLoc(emitLoc);
+   emitComment((char *)"END WHILE");
+   loop = NULL;
+}
+
+/* ==================================================
+   GENERATE FOR
+   ================================================== */
+void generate_for(Node *node)
+{
+   loop = node;
+   Node *cdn = node->child[0];
+   Node *range = node->child[1];
+   Node *stmt = node->child[2];
+
+   int toffset_temp = toffset;
+   toffset = node->size;
+   emitComment((char *)"TOFF set:", toffset);
+   emitComment((char *)"FOR");
+   // 0. Insert cdm
+   gcST.insert(cdn->literal, cdn);
+   if ((idiom_flag && generate_bulk_for(node)) || (unroll_flag && generate_unrolled_for(node)) ||
+       (regloop_flag && generate_register_for(node)) ||
+       (rotate_flag && generate_rotated_for(node)))
+   {
+      toffset = toffset_temp;
+      if (node->sibling != NULL && node->sibling->nodeType != ToNT)
+      {
+         toffset -= 3;
+      }
+      loop = NULL;
+      return;
+   }
+   // 1. Load in Range
+   if (load_in(range->child[0]) == false)
+   {
+      switch (range->child[0]->nodeType)
+      {
+      case OpNT:
+         generate_op(range->child[0]);
+         break;
+      }
+   }
+   emitRM((char *)"ST", 3, toffset_temp, 1, (char *)"save starting value in index variable");
+   if (load_in(range->child[1]) == false)
+   {
+      switch (range->child[1]->nodeType)
+      {
+      case OpNT:
+         generate_op(range->child[1]);
+         break;
+      case SizeOfNT:
+         generate_sizeof(range->child[1]);
+         break;
+      }
+   }
+   emitRM((char *)"ST", 3, toffset_temp - 1, 1, (char *)"save stop value");
+   if (range->child[2] == NULL)
+   {
+      emitRM((char *)"LDC", 3, 1, 6, (char *)"default increment by 1");
+   }
+   else
+   {
+      if (load_in(range->child[2]) == false)
+      {
+         switch (range->child[2]->nodeType)
+         {
+         case SignNT:
+            generate_ChSign(range->child[2]);
+            break;
+         case OpNT:
+            generate_op(range->child[2]);
+            break;
+         }
+      }
+   }
+   // toffset = toffset_temp;
+   int L1 = emitWhereAmI();
+   toffset = toffset_temp;
+   emitRM((char *)"ST", 3, toffset - 2, 1, (char *)"save step value");
+   emitRM((char *)"LD", 4, toffset, 1, (char *)"loop index");
+   emitRM((char *)"LD", 5, toffset - 1, 1, (char *)"stop value");
+   emitRM((char *)"LD", 3, toffset - 2, 1, (char *)"step value");
+   emitRO((char *)"SLT", 3, 4, 5, (char *)"Op <");
+   emitRM((char *)"JNZ", 3, 1, 7, (char *)"Jump to loop body");
+   toffset = node->size;
+   coverage_probe("exit", node);
+   int backpatch = emitSkip(1);
+   generate_for_compound(stmt, node);
+   emitComment((char *)"Bottom of loop increment and jump");
+   emitRM((char *)"LD", AC, toffset_temp, 1, (char *)"Load index");
+   emitRM((char *)"LD", AC2, toffset_temp - 2, 1, (char *)"Load step");
+   emitRO((char *)"ADD", 3, 3, 5, (char *)"increment");
+   emitRM((char *)"ST", 3, toffset_temp, 1, (char *)"store back to index");
+   emitRM((char *)"JMP", 7, L1 - emitWhereAmI(), 7, (char *)"go to beginning of loop");
+   // printf("l1 %d\n", L1);
+   // printf("toff %d\n", toffset);
+   // printf("temp toff %d\n", toffset_temp);
+   // printf("bp %d\n", backpatch);
+   // printf("RN %d\n", emitWhereAmI());
+   //  emitRM((char *)"JMP", 7, backpatch - emitWhereAmI() + toffset_temp - 1, 7, (char *)"go to beginning of loop");
+   int emitLoc = emitWhereAmI();
+   emitNewLoc(backpatch);
+   emitRM((char *)"JMP", 7, emitLoc - backpatch - 1, 7, (char *)"Jump past loop [backpatch]");
+   emitNewLoc(emitLoc);
+   emitComment((char *)"END LOOP");
+   toffset = toffset_temp;
+   if (node->sibling != NULL)
+   {
+      if (node->sibling->nodeType != ToNT)
+      {
+         toffset -= 3;
+      }
+   }
+   loop = NULL;
+}
+
+/* ==================================================
+   GENERATE EMBEDDED FOR LOOP
+   ================================================== */
+
+/* ==================================================
+   GENERATE RANGE
+   ================================================== */
+void generate_range(Node *node)
+{
+}
+
+/* ==================================================
+   GLOBAL CONSTANTS
+   ================================================== */
+void generate_constant(Node *node)
+{
+}
+
+/* ==================================================
+   GLOBAL CONSTANTS
+   ================================================== */
+void generate_id(Node *node)
+{
+}
+
+/* ==================================================
+   GENERATE INLINE I/O
+   ================================================== */
+// A call of a built-in I/O routine becomes its IN*/OUT* instruction on AC,
+// which is where the argument is computed and where the result is expected.
+static bool generate_inline_io(Node *node)
+{
+   static const char *names[] = {"input", "inputb", "inputc", "output", "outputb", "outputc", "outnl"};
+   static const char *ops[] = {"IN", "INB", "INC", "OUT", "OUTB", "OUTC", "OUTNL"};
+   Node *call_sym = fetchSymbol(node, &gcST);
+   if (call_sym == NULL || !call_sym->isLib)
+      return false;
+   for (int n = 0; n < 7; n++)
+   {
+      if (strcmp(call_sym->literal, names[n]) == 0)
+      {
+         emitComment((char *)"CALL (inline)", node->literal);
+         if (node->child[0] != NULL)
+            generate_passed_parms(node->child[0], 1);
+         emitRO((char *)ops[n], 3, 3, 3, (char *)"Inline", node->literal);
+         emitComment((char *)"Call end", node->literal);
+         count_changes(PASS_INLINE_IO, 1);
+         return true;
+      }
+   }
+   return false;
+}
+
+/* ==================================================
+   GENERATE CALL
+   ================================================== */
+void generate_call(Node *node)
+{
+   if (inline_io_flag && generate_inline_io(node))
+      return;
+   char msg[32];
+   int toffset_temp = toffset;
+   emitComment((char *)"CALL", node->literal);
+   emitRM((char *)"ST", 1, toffset, 1, (char *)"Store fp in ghost frame for", node->literal);
+   toffset -= 1;
+   emitComment((char *)"TOFF dec:", toffset);
+   toffset -= 1;
+   emitComment((char *)"TOFF dec:", toffset);
+
+   Node *parm = node->child[0];
+   if (parm != NULL)
+   {
+      int n = 1;
+      while (parm != NULL)
+      {
+         generate_passed_parms(parm, n);
+         emitRM((char *)"ST", 3, toffset, 1, (char *)"Push parameter");
+         toffset -= 1;
+         emitComment((char *)"TOFF dec:", toffset);
+         n++;
+         parm = parm->sibling;
+         if (parm == NULL)
+         {
+            emitComment((char *)"Param end", node->literal);
+         }
+      }
+   }
+   else
+   {
+      emitComment((char *)"Param end", node->literal);
+   }
+   toffset = toffset_temp;
+   Node *call_sym = fetchSymbol(node, &gcST);
+   if (!keeps_regs(call_sym))
+      spill_loop_regs();
+   emitRM((char *)"LDA", 1, toffset, 1, (char *)"Ghost frame becomes new active frame");
+   emitRM((char *)"LDA", 3, 1, 7, (char *)"Return address in ac");
+
+   profile_site("call", node, call_sym->literal);
+   emitRM((char *)"JMP", 7, call_sym->address - emitWhereAmI() - 1, 7, (char *)"CALL", node->literal);
+   emitRM((char *)"LDA", 3, 0, 2, (char *)"Save the result in ac");
+   if (!keeps_regs(call_sym))
+      reload_loop_regs();
+   emitComment((char *)"Call end", node->literal);
+   emitComment((char *)"TOFF set:", toffset);
+}
+
+/* ==================================================
+   GENERATE PARAMETERS
+   ================================================== */
+void generate_passed_parms(Node *node, int c)
+{
+   emitComment((char *)"Param", c);
+   if (load_in(node) == false)
+   {
+      // Handle other nodetypes...
+      switch (node->nodeType)
+      {
+      case AssignNT:
+         generate_assignment(node);
+         break;
+      case OpNT:
+         generate_op(node);
+         break;
+      case AndNT:
+         generate_and_or(node);
+         break;
+      case OrNT:
+         generate_and_or(node);
+         break;
+      case SignNT:
+         generate_ChSign(node);
+         break;
+      case NotNT:
+         generate_not(node);
+         break;
+      case QuesNT:
+         generate_Ques(node);
+         break;
+      case ArrNT:
+         load_arr_op(node);
+         break;
+      case CallNT:
+         generate_call(node);
+         break;
+      case SizeOfNT:
+         generate_sizeof(node);
+         break;
+      }
+   }
+   if (node->nodeType == StringConstNT)
+   {
+      emitStrLit(string_offset, node->data.String);
+      string_offset -= node->size;
+      emitRM((char *)"LDA", 3, node->location, node->refType, (char *)"Load address of char array");
+   }
+}
+
+/* ==================================================
+   GENERATE RETURN
+   ================================================== */
+void generate_return(Node *node)
+{
+   emitComment((char *)"RETURN");
+   if (current_function->hasReturn)
+   {
+      if (load_in(node->child[0]) == false && load_arr_op(node->child[0]) == false)
+      {
+         switch (node->child[0]->nodeType)
+         {
+         case OpNT:
+            generate_op(node->child[0]);
+            break;
+         case ArrNT:
+            load_arr_op(node->child[0]);
+            break;
+         case CallNT:
+            generate_call(node->child[0]);
+            break;
+         case SizeOfNT:
+            generate_sizeof(node->child[0]);
+            break;
+         case AndNT:
+            generate_and_or(node->child[0]);
+            break;
+         }
+      }
+      // Globals held in registers go back to memory before RT is overwritten.
+      store_promoted_globals();
+      emitRM((char *)"LDA", 2, 0, 3, (char *)"Copy result to return register");
+   }
+   else
+   {
+      store_promoted_globals();
+   }
+   emitRM((char *)"LD", 3, -1, 1, (char *)"Load return address");
+   emitRM((char *)"LD", 1, 0, 1, (char *)"Adjust fp");
+   emitRM((char *)"JMP", 7, 0, 3, (char *)"Return");
+}
+
+/* ==================================================
+   GENERATE QUESNT
+   ================================================== */
+void generate_Ques(Node *node)
+{
+   load_in(node->child[0]);
+   emitRO((char *)"RND", 3, 3, 6, (char *)"Op ?");
+}
+
+/* ==================================================
+   GENERATE CHSIGNNT
+   ================================================== */
+void generate_ChSign(Node *node)
+{
+   if (load_in(node->child[0]) == false)
+   {
+      switch (node->child[0]->nodeType)
+      {
+      case OpNT:
+         generate_op(node->child[0]);
+         break;
+      case SignNT:
+         generate_ChSign(node->child[0]);
+         break;
+      }
+   }
+   emitRO((char *)"NEG", 3, 3, 3, (char *)"Op unary -");
+}
+/* ==================================================
+   GENERATE CHSIGNNT
+   ================================================== */
+void generate_sizeof(Node *node)
+{
+   Node *arr = fetchSymbol(node->child[0], &gcST);
+
+   if (arr->nodeType == ParmArrNT)
+   {
+      emitRM((char *)"LD", AC, arr->location, arr->refType, (char *)"Load address of base of array", arr->literal);
+   }
+   else if (arr->nodeType == VarArrNT)
+   {
+      if (arr->dataType == CharDT)
+      {
+         if (arr->refType == GlobalRT && arr->nodeType == ParmArrNT)
+         {
+            emitRM((char *)"LDA", AC, arr->location, arr->refType, (char *)"Load address of base of array", arr->literal);
+         }
+         else
+         {
+            emitRM((char *)"LD", AC, arr->location, arr->refType, (char *)"Load address of base of array", arr->literal);
+         }
+      }
+      else
+      {
+         emitRM((char *)"LDA", AC, arr->location, arr->refType, (char *)"Load address of base of array", arr->literal);
+      }
+   }
+   else
+   {
+      emitRM((char *)"LDA", AC, arr->location, arr->refType, (char *)"Load address of base of array", arr->literal);
+   }
+   emitRM((char *)"LD", 3, 1, 3, (char *)"Load array size");
+}
+
+void generate_string(Node *node)
+{
+   if (node->nodeType == StringConstNT && curr_decl != NULL)
+   {
+      emitStrLit(string_offset, node->data.String);
+      string_offset -= node->size;
+      emitRM((char *)"LDA", 3, node->location, node->refType, (char *)"Load address of char array");
+      spill_loop_regs();
+      emitRM((char *)"LDA", 4, curr_decl->location, curr_decl->refType, (char *)"address of lhs");
+      emitRM((char *)"LD", 5, 1, 3, (char *)"size of rhs");
+      emitRM((char *)"LD", 6, 1, 4, (char *)"size of lhs");
+      emitRO((char *)"SWP", 5, 6, 6, (char *)"pick smallest size");
+      emitRO((char *)"MOV", 4, 3, 5, (char *)"array op =");
+      reload_loop_regs();
+   }
 }
\ No newline at end of file
@@ -0,0 +1,1030 @@
+#include "code_gen_x86.hpp"
+#include "parser.tab.h"
+#include <ctype.h>
+#include <stdarg.h>
+#include <string.h>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+#define X86_STACK_WORDS (1 << 20) // Words of the data stack that holds the frames.
+
+extern FILE *code;
+extern int goffset;
+
+static map<string, Node *> x86_funcs; // Functions by name.
+static vector<Node *> x86_globals;    // Globals and statics, in tree order.
+static vector<Node *> x86_strings;    // String constants.
+static vector<int> x86_breaks;        // Exit label of the enclosing loops.
+static int x86_labels = 0;
+static int x86_return;      // Label of the epilogue of the current function.
+static int x86_scope = -2;  // First free slot of the current scope (TM's toffset).
+static int x86_floor = 0;   // Lowest frame slot any code touches.
+
+/* ==================================================
+   RUNTIME
+   ================================================== */
+// The C main(), which sets up the first frame, initializes globals and
+// statics and calls the C- main(), comes before this. Values are read one
+// per line from stdin (inputc reads the characters of a line, newline
+// included) and written like the TM OUT* instructions.
+static const char *runtime[] = {
+    "# rt_read(&line, &cap): next input line, exits at the end of input",
+    "rt_read:",
+    "\tpush %rbp",
+    "\tmov %rsp,%rbp",
+    "\tpush %rdi",
+    "\tpush %rsi",
+    "\tmov stdout@GOTPCREL(%rip),%rax",
+    "\tmov (%rax),%rdi",
+    "\tcall fflush@PLT",
+    "\tpop %rsi",
+    "\tpop %rdi",
+    "\tmov stdin@GOTPCREL(%rip),%rdx",
+    "\tmov (%rdx),%rdx",
+    "\tcall getline@PLT",
+    "\ttest %rax,%rax",
+    "\tjs rt_no_input",
+    "\tpop %rbp",
+    "\tret",
+    "",
+    "rt_input:",
+    "\tpush %rbp",
+    "\tmov %rsp,%rbp",
+    "\tand $-16,%rsp",
+    "\tlea rt_line(%rip),%rdi",
+    "\tlea rt_cap(%rip),%rsi",
+    "\tcall rt_read",
+    "\tmov rt_line(%rip),%rdi",
+    "\tcall atoll@PLT",
+    "\tleave",
+    "\tret",
+    "",
+    "# T/t and F/f after blanks, otherwise a number (not 0 is true)",
+    "rt_inputb:",
+    "\tpush %rbp",
+    "\tmov %rsp,%rbp",
+    "\tand $-16,%rsp",
+    "\tlea rt_line(%rip),%rdi",
+    "\tlea rt_cap(%rip),%rsi",
+    "\tcall rt_read",
+    "\tmov rt_line(%rip),%rdi",
+    "1:\tmovzbl (%rdi),%eax",
+    "\tcmp $32,%eax",
+    "\tje 2f",
+    "\tcmp $9,%eax",
+    "\tjne 3f",
+    "2:\tinc %rdi",
+    "\tjmp 1b",
+    "3:\tor $32,%eax",
+    "\tcmp $116,%eax",
+    "\tje 4f",
+    "\tcmp $102,%eax",
+    "\tje 5f",
+    "\tmov rt_line(%rip),%rdi",
+    "\tcall atoll@PLT",
+    "\ttest %rax,%rax",
+    "\tsetne %al",
+    "\tmovzbl %al,%eax",
+    "\tleave",
+    "\tret",
+    "4:\tmov $1,%eax",
+    "\tleave",
+    "\tret",
+    "5:\txor %eax,%eax",
+    "\tleave",
+    "\tret",
+    "",
+    "rt_inputc:",
+    "\tmov rt_cpos(%rip),%rax",
+    "\ttest %rax,%rax",
+    "\tjnz 1f",
+    "\tpush %rbp",
+    "\tmov %rsp,%rbp",
+    "\tand $-16,%rsp",
+    "\tlea rt_cline(%rip),%rdi",
+    "\tlea rt_ccap(%rip),%rsi",
+    "\tcall rt_read",
+    "\tleave",
+    "\tmov rt_cline(%rip),%rax",
+    "1:\tmovzbl (%rax),%ecx",
+    "\ttest %ecx,%ecx",
+    "\tjz 2f",
+    "\tcmp $10,%ecx",
+    "\tje 2f",
+    "\tinc %rax",
+    "\tmov %rax,rt_cpos(%rip)",
+    "\tmov %rcx,%rax",
+    "\tret",
+    "2:\tmovq $0,rt_cpos(%rip)",
+    "\tmov $10,%eax",
+    "\tret",
+    "",
+    "rt_output:",
+    "\tpush %rbp",
+    "\tmov %rsp,%rbp",
+    "\tand $-16,%rsp",
+    "\tmov %rdi,%rsi",
+    "\tlea rt_int(%rip),%rdi",
+    "\txor %eax,%eax",
+    "\tcall printf@PLT",
+    "\tleave",
+    "\tret",
+    "",
+    "rt_outputb:",
+    "\tpush %rbp",
+    "\tmov %rsp,%rbp",
+    "\tand $-16,%rsp",
+    "\ttest %rdi,%rdi",
+    "\tlea rt_true(%rip),%rdi",
+    "\tlea rt_false(%rip),%rax",
+    "\tcmovz %rax,%rdi",
+    "\tmov stdout@GOTPCREL(%rip),%rsi",
+    "\tmov (%rsi),%rsi",
+    "\tcall fputs@PLT",
+    "\tleave",
+    "\tret",
+    "",
+    "rt_outputc:",
+    "\tpush %rbp",
+    "\tmov %rsp,%rbp",
+    "\tand $-16,%rsp",
+    "\tmovzbl %dil,%edi",
+    "\tcall putchar@PLT",
+    "\tleave",
+    "\tret",
+    "",
+    "rt_outnl:",
+    "\tpush %rbp",
+    "\tmov %rsp,%rbp",
+    "\tand $-16,%rsp",
+    "\tmov $10,%edi",
+    "\tcall putchar@PLT",
+    "\tleave",
+    "\tret",
+    "",
+    "# rt_random(n): rand() % n, 0 unless n > 0",
+    "rt_random:",
+    "\txor %eax,%eax",
+    "\ttest %rdi,%rdi",
+    "\tjle 1f",
+    "\tpush %rbp",
+    "\tmov %rsp,%rbp",
+    "\tpush %rdi",
+    "\tand $-16,%rsp",
+    "\tcall rand@PLT",
+    "\tcltq",
+    "\tmov -8(%rbp),%rcx",
+    "\tcall rt_mod",
+    "\tleave",
+    "1:\tret",
+    "",
+    "# rt_mod(%rax, %rcx): %rax % %rcx as the TM computes it, a negative",
+    "# remainder gets |%rcx| added; clobbers %rdx",
+    "rt_mod:",
+    "\tcqo",
+    "\tidiv %rcx",
+    "\tmov %rdx,%rax",
+    "\tmov %rcx,%rdx",
+    "\tneg %rdx",
+    "\tcmovl %rcx,%rdx",
+    "\tadd %rax,%rdx",
+    "\ttest %rax,%rax",
+    "\tcmovl %rdx,%rax",
+    "\tret",
+    "",
+    "# rt_compare(lhs, rhs): the first elements that differ in %rax and %rdx,",
+    "# the sizes if the shorter array is a prefix of the other",
+    "rt_compare:",
+    "\tmov 8(%rdi),%r10",
+    "\tmov 8(%rsi),%r11",
+    "\tmov %r10,%rcx",
+    "\tcmp %r11,%rcx",
+    "\tcmovg %r11,%rcx",
+    "1:\ttest %rcx,%rcx",
+    "\tjle 2f",
+    "\tmov (%rdi),%rax",
+    "\tmov (%rsi),%rdx",
+    "\tcmp %rdx,%rax",
+    "\tjne 3f",
+    "\tsub $8,%rdi",
+    "\tsub $8,%rsi",
+    "\tdec %rcx",
+    "\tjmp 1b",
+    "2:\tmov %r10,%rax",
+    "\tmov %r11,%rdx",
+    "3:\tret",
+    "",
+    "# rt_copy(to, from): copies as many elements as the smaller array holds",
+    "rt_copy:",
+    "\tmov 8(%rdi),%rcx",
+    "\tcmp 8(%rsi),%rcx",
+    "\tcmovg 8(%rsi),%rcx",
+    "1:\ttest %rcx,%rcx",
+    "\tjle 2f",
+    "\tmov (%rsi),%rax",
+    "\tmov %rax,(%rdi)",
+    "\tsub $8,%rsi",
+    "\tsub $8,%rdi",
+    "\tdec %rcx",
+    "\tjmp 1b",
+    "2:\tret",
+    "",
+    "rt_no_input:",
+    "\tlea rt_no_input_msg(%rip),%rdi",
+    "\tjmp rt_stop",
+    "rt_overflow:",
+    "\tlea rt_overflow_msg(%rip),%rdi",
+    "rt_stop:",
+    "\tand $-16,%rsp",
+    "\tmov stderr@GOTPCREL(%rip),%rsi",
+    "\tmov (%rsi),%rsi",
+    "\tcall fputs@PLT",
+    "\tmov $1,%edi",
+    "\tcall exit@PLT",
+    "",
+    "\t.section .rodata",
+    "rt_int:\t.string \"%lld \"",
+    "rt_true:\t.string \"T \"",
+    "rt_false:\t.string \"F \"",
+    "rt_no_input_msg:\t.string \"Out of input\\n\"",
+    "rt_overflow_msg:\t.string \"Data memory access out of range\\n\"",
+    "",
+    "\t.bss",
+    "\t.balign 8",
+    "rt_line:\t.zero 8",
+    "rt_cap:\t.zero 8",
+    "rt_cline:\t.zero 8",
+    "rt_ccap:\t.zero 8",
+    "rt_cpos:\t.zero 8",
+    NULL};
+
+/* ==================================================
+   EMIT
+   ================================================== */
+static void x86_emit(const char *fmt, ...)
+{
+   va_list args;
+   va_start(args, fmt);
+   fputc('\t', code);
+   vfprintf(code, fmt, args);
+   fputc('\n', code);
+   va_end(args);
+}
+
+static int x86_new_label()
+{
+   return x86_labels++;
+}
+
+static void x86_label(int label)
+{
+   fprintf(code, ".L%d:\n", label);
+}
+
+// C- names as assembler symbols; clones made by -fspecialize are "f-SP1".
+static string x86_func_name(const char *name)
+{
+   string sym = "f.";
+   for (const char *p = name; *p != '\0'; p++)
+      sym += isalnum((unsigned char)*p) || *p == '_' ? *p : '.';
+   return sym;
+}
+
+// Operand of the word at a location: below cm_gp for globals and statics,
+// in the frame otherwise.
+static string x86_slot(int location, RefType refType)
+{
+   char buf[48];
+   if (refType == GlobalRT || refType == StaticRT)
+   {
+      sprintf(buf, "cm_gp%+d(%%rip)", 8 * location);
+   }
+   else
+   {
+      if (location < x86_floor)
+         x86_floor = location;
+      sprintf(buf, "%d(%%rbx)", 8 * location);
+   }
+   return buf;
+}
+
+/* ==================================================
+   OPERANDS
+   ================================================== */
+static bool x86_const(Node *node, long long *value)
+{
+   if (node == NULL || !node->isConst)
+      return false;
+   switch (node->tknClass)
+   {
+   case NUMCONST:
+   case BOOLCONST:
+      *value = node->data.Int;
+      return true;
+   case CHARCONST:
+      *value = node->data.Char;
+      return true;
+   }
+   return false;
+}
+
+// A whole array (not an element) used as a value: its base address.
+static bool x86_is_array(Node *node)
+{
+   return node->isArray && node->nodeType != ArrNT;
+}
+
+// Operands loaded with one instruction, without touching other registers.
+static bool x86_is_leaf(Node *node)
+{
+   long long value;
+   return x86_const(node, &value) || (node->nodeType == IdNT && !node->isArray);
+}
+
+static void x86_load_leaf(Node *node, const char *reg)
+{
+   long long value;
+   if (x86_const(node, &value))
+      x86_emit("mov $%lld,%s", value, reg);
+   else
+      x86_emit("mov %s,%s", x86_slot(node->location, node->refType).c_str(), reg);
+}
+
+// Array parameters hold the base address, other arrays start at their slot.
+static void x86_array_base(Node *array, const char *reg)
+{
+   if (array->refType == ParamRT)
+      x86_emit("mov %s,%s", x86_slot(array->location, array->refType).c_str(), reg);
+   else
+      x86_emit("lea %s,%s", x86_slot(array->location, array->refType).c_str(), reg);
+}
+
+/* ==================================================
+   EXPRESSIONS
+   ================================================== */
+static void x86_expr(Node *node);
+
+// %rax <- lhs, %rcx <- rhs
+static void x86_operands(Node *lhs, Node *rhs)
+{
+   x86_expr(lhs);
+   if (x86_is_leaf(rhs))
+   {
+      x86_load_leaf(rhs, "%rcx");
+      return;
+   }
+   x86_emit("push %%rax");
+   x86_expr(rhs);
+   x86_emit("mov %%rax,%%rcx");
+   x86_emit("pop %%rax");
+}
+
+// Char arrays compare by their first differing elements (rt_compare).
+static void x86_compare_arrays(Node *lhs, Node *rhs)
+{
+   x86_expr(lhs);
+   x86_emit("push %%rax");
+   x86_expr(rhs);
+   x86_emit("mov %%rax,%%rsi");
+   x86_emit("pop %%rdi");
+   x86_emit("call rt_compare");
+   x86_emit("mov %%rdx,%%rcx");
+}
+
+static const char *x86_condition(int tknClass)
+{
+   switch (tknClass)
+   {
+   case EQL:
+      return "e";
+   case NEQ:
+      return "ne";
+   case LESS:
+      return "l";
+   case LEQ:
+      return "le";
+   case GREAT:
+      return "g";
+   case GEQ:
+      return "ge";
+   }
+   return NULL;
+}
+
+static const char *x86_negated(int tknClass)
+{
+   switch (tknClass)
+   {
+   case EQL:
+      return "ne";
+   case NEQ:
+      return "e";
+   case LESS:
+      return "ge";
+   case LEQ:
+      return "g";
+   case GREAT:
+      return "le";
+   case GEQ:
+      return "l";
+   }
+   return NULL;
+}
+
+static void x86_binary(Node *node)
+{
+   Node *lhs = node->child[0];
+   Node *rhs = node->child[1];
+   if (x86_is_array(lhs) || x86_is_array(rhs))
+      x86_compare_arrays(lhs, rhs);
+   else
+      x86_operands(lhs, rhs);
+
+   if (node->nodeType == AndNT)
+   {
+      x86_emit("and %%rcx,%%rax");
+      return;
+   }
+   if (node->nodeType == OrNT)
+   {
+      x86_emit("or %%rcx,%%rax");
+      return;
+   }
+   switch (node->tknClass)
+   {
+   case ADD:
+      x86_emit("add %%rcx,%%rax");
+      break;
+   case SUB:
+      x86_emit("sub %%rcx,%%rax");
+      break;
+   case MUL:
+      x86_emit("imul %%rcx,%%rax");
+      break;
+   case DIV:
+      x86_emit("cqo");
+      x86_emit("idiv %%rcx");
+      break;
+   case MOD:
+      x86_emit("call rt_mod");
+      break;
+   default:
+      x86_emit("cmp %%rcx,%%rax");
+      x86_emit("set%s %%al", x86_condition(node->tknClass));
+      x86_emit("movzbl %%al,%%eax");
+      break;
+   }
+}
+
+static void x86_element(Node *node)
+{
+   Node *array = node->child[0];
+   Node *idx = node->child[1];
+   long long k;
+   if (x86_const(idx, &k) && array->refType != ParamRT)
+   {
+      x86_emit("mov %s,%%rax", x86_slot(array->location - k, array->refType).c_str());
+      return;
+   }
+   x86_expr(idx);
+   x86_array_base(array, "%rcx");
+   x86_emit("neg %%rax");
+   x86_emit("mov (%%rcx,%%rax,8),%%rax");
+}
+
+static void x86_call(Node *node)
+{
+   Node *func = x86_funcs[node->literal];
+   if (func->isLib)
+   {
+      if (node->child[0] != NULL)
+      {
+         x86_expr(node->child[0]);
+         x86_emit("mov %%rax,%%rdi");
+      }
+      x86_emit("call rt_%s", func->literal);
+      return;
+   }
+   // Arguments go to the ghost frame at the first free slot, calls inside
+   // them below the arguments already stored.
+   int ghost = x86_scope;
+   x86_scope -= 2;
+   for (Node *arg = node->child[0]; arg != NULL; arg = arg->sibling)
+   {
+      x86_expr(arg);
+      x86_emit("mov %%rax,%s", x86_slot(x86_scope, LocalRT).c_str());
+      x86_scope -= 1;
+   }
+   x86_scope = ghost;
+   string frame = x86_slot(ghost, LocalRT);
+   x86_emit("mov %%rbx,%s", frame.c_str());
+   x86_emit("lea %s,%%rbx", frame.c_str());
+   x86_emit("call %s", x86_func_name(node->literal).c_str());
+}
+
+static void x86_assign(Node *node)
+{
+   Node *lhs = node->child[0];
+   Node *rhs = node->child[1];
+   string dst;
+
+   if (lhs->nodeType != ArrNT && lhs->isArray)
+   {
+      x86_expr(rhs);
+      x86_emit("mov %%rax,%%rsi");
+      x86_array_base(lhs, "%rdi");
+      x86_emit("call rt_copy");
+      return;
+   }
+   if (lhs->nodeType == ArrNT)
+   {
+      Node *array = lhs->child[0];
+      Node *idx = lhs->child[1];
+      long long k;
+      if (x86_const(idx, &k) && array->refType != ParamRT)
+      {
+         dst = x86_slot(array->location - k, array->refType);
+         if (rhs != NULL)
+            x86_expr(rhs);
+      }
+      else if (rhs == NULL || x86_is_leaf(rhs))
+      {
+         x86_expr(idx);
+         x86_array_base(array, "%rsi");
+         x86_emit("neg %%rax");
+         x86_emit("lea (%%rsi,%%rax,8),%%rsi");
+         if (rhs != NULL)
+            x86_load_leaf(rhs, "%rax");
+         dst = "(%rsi)";
+      }
+      else
+      {
+         // The index is computed before the value, as in TM code.
+         x86_expr(idx);
+         x86_emit("push %%rax");
+         x86_expr(rhs);
+         x86_emit("pop %%rcx");
+         x86_array_base(array, "%rsi");
+         x86_emit("neg %%rcx");
+         x86_emit("lea (%%rsi,%%rcx,8),%%rsi");
+         dst = "(%rsi)";
+      }
+   }
+   else
+   {
+      dst = x86_slot(lhs->location, lhs->refType);
+      if (rhs != NULL)
+         x86_expr(rhs);
+   }
+
+   const char *d = dst.c_str();
+   switch (node->tknClass)
+   {
+   case ASGN:
+      x86_emit("mov %%rax,%s", d);
+      break;
+   case ADDASS:
+      x86_emit("add %%rax,%s", d);
+      x86_emit("mov %s,%%rax", d);
+      break;
+   case SUBASS:
+      x86_emit("sub %%rax,%s", d);
+      x86_emit("mov %s,%%rax", d);
+      break;
+   case MULASS:
+      x86_emit("imul %s,%%rax", d);
+      x86_emit("mov %%rax,%s", d);
+      break;
+   case DIVASS:
+      x86_emit("mov %%rax,%%rcx");
+      x86_emit("mov %s,%%rax", d);
+      x86_emit("cqo");
+      x86_emit("idiv %%rcx");
+      x86_emit("mov %%rax,%s", d);
+      break;
+   case INC:
+      x86_emit("addq $1,%s", d);
+      x86_emit("mov %s,%%rax", d);
+      break;
+   case DEC:
+      x86_emit("subq $1,%s", d);
+      x86_emit("mov %s,%%rax", d);
+      break;
+   }
+}
+
+// %rax <- value of the expression
+static void x86_expr(Node *node)
+{
+   long long value;
+   if (x86_const(node, &value))
+   {
+      x86_emit("mov $%lld,%%rax", value);
+      return;
+   }
+   switch (node->nodeType)
+   {
+   case StringConstNT:
+      x86_emit("lea %s,%%rax", x86_slot(node->location, GlobalRT).c_str());
+      break;
+   case IdNT:
+      if (node->isArray)
+         x86_array_base(node, "%rax");
+      else
+         x86_load_leaf(node, "%rax");
+      break;
+   case ArrNT:
+      x86_element(node);
+      break;
+   case OpNT:
+   case AndNT:
+   case OrNT:
+      x86_binary(node);
+      break;
+   case NotNT:
+      x86_expr(node->child[0]);
+      x86_emit("xor $1,%%rax");
+      break;
+   case SignNT:
+      x86_expr(node->child[0]);
+      x86_emit("neg %%rax");
+      break;
+   case SizeOfNT:
+      x86_array_base(node->child[0], "%rax");
+      x86_emit("mov 8(%%rax),%%rax");
+      break;
+   case QuesNT:
+      x86_expr(node->child[0]);
+      x86_emit("mov %%rax,%%rdi");
+      x86_emit("call rt_random");
+      break;
+   case CallNT:
+      x86_call(node);
+      break;
+   case AssignNT:
+      x86_assign(node);
+      break;
+   default:
+      break;
+   }
+}
+
+// Jumps to label when the condition is false; comparisons branch on the
+// flags instead of making a 0/1 value.
+static void x86_jump_false(Node *cond, int label)
+{
+   if (cond->nodeType == OpNT && x86_negated(cond->tknClass) != NULL &&
+       !x86_is_array(cond->child[0]) && !x86_is_array(cond->child[1]))
+   {
+      x86_operands(cond->child[0], cond->child[1]);
+      x86_emit("cmp %%rcx,%%rax");
+      x86_emit("j%s .L%d", x86_negated(cond->tknClass), label);
+      return;
+   }
+   x86_expr(cond);
+   x86_emit("test %%rax,%%rax");
+   x86_emit("jz .L%d", label);
+}
+
+/* ==================================================
+   STATEMENTS
+   ================================================== */
+static void x86_stmts(Node *node);
+
+// Local arrays get their size, locals their initializer; globals and
+// statics are set up once before main().
+static void x86_decls(Node *decl)
+{
+   for (; decl != NULL; decl = decl->sibling)
+   {
+      if (decl->refType != LocalRT)
+         continue;
+      if (decl->isArray)
+      {
+         x86_emit("movq $%d,%s", decl->size - 1, x86_slot(decl->location + 1, LocalRT).c_str());
+         if (decl->child[0] != NULL)
+         {
+            x86_expr(decl->child[0]);
+            x86_emit("mov %%rax,%%rsi");
+            x86_array_base(decl, "%rdi");
+            x86_emit("call rt_copy");
+         }
+      }
+      else if (decl->child[0] != NULL)
+      {
+         x86_expr(decl->child[0]);
+         x86_emit("mov %%rax,%s", x86_slot(decl->location, LocalRT).c_str());
+      }
+   }
+}
+
+static void x86_compound(Node *node)
+{
+   int scope = x86_scope;
+   x86_scope = node->size;
+   x86_decls(node->child[0]);
+   x86_stmts(node->child[1]);
+   x86_scope = scope;
+}
+
+static void x86_if(Node *node)
+{
+   int elseLabel = x86_new_label();
+   x86_jump_false(node->child[0], elseLabel);
+   x86_stmts(node->child[1]);
+   if (node->child[2] == NULL)
+   {
+      x86_label(elseLabel);
+      return;
+   }
+   int endLabel = x86_new_label();
+   x86_emit("jmp .L%d", endLabel);
+   x86_label(elseLabel);
+   x86_stmts(node->child[2]);
+   x86_label(endLabel);
+}
+
+static void x86_while(Node *node)
+{
+   int top = x86_new_label();
+   int exit = x86_new_label();
+   x86_label(top);
+   x86_jump_false(node->child[0], exit);
+   x86_breaks.push_back(exit);
+   x86_stmts(node->child[1]);
+   x86_breaks.pop_back();
+   x86_emit("jmp .L%d", top);
+   x86_label(exit);
+}
+
+// for i <= a .. b step c: the index lives in its slot, b and c are pushed
+// (stop at 8(%rsp), step at (%rsp)) and the loop runs while i < b (i > b
+// for a step that is not positive), as the TM SLT test does.
+static void x86_for(Node *node)
+{
+   Node *index = node->child[0];
+   Node *range = node->child[1];
+   int scope = x86_scope;
+   x86_scope = node->size;
+   string slot = x86_slot(index->location, index->refType);
+   const char *i = slot.c_str();
+
+   x86_expr(range->child[0]);
+   x86_emit("mov %%rax,%s", i);
+   x86_expr(range->child[1]);
+   x86_emit("push %%rax");
+   long long step = 1;
+   bool constStep = range->child[2] == NULL || x86_const(range->child[2], &step);
+   if (constStep)
+   {
+      x86_emit("pushq $%lld", step);
+   }
+   else
+   {
+      x86_expr(range->child[2]);
+      x86_emit("push %%rax");
+   }
+
+   int test = x86_new_label();
+   int body = x86_new_label();
+   int done = x86_new_label();
+   int exit = x86_new_label();
+   x86_label(test);
+   x86_emit("mov %s,%%rax", i);
+   x86_emit("cmp 8(%%rsp),%%rax");
+   if (constStep)
+   {
+      x86_emit("j%s .L%d", step > 0 ? "ge" : "le", exit);
+   }
+   else
+   {
+      int down = x86_new_label();
+      x86_emit("cmpq $0,(%%rsp)");
+      x86_emit("jle .L%d", down);
+      x86_emit("cmp 8(%%rsp),%%rax");
+      x86_emit("jge .L%d", exit);
+      x86_emit("jmp .L%d", body);
+      x86_label(down);
+      x86_emit("cmp 8(%%rsp),%%rax");
+      x86_emit("jle .L%d", exit);
+   }
+   x86_label(body);
+   x86_breaks.push_back(exit);
+   x86_stmts(node->child[2]);
+   x86_breaks.pop_back();
+   x86_label(done);
+   if (constStep)
+   {
+      x86_emit("addq $%lld,%s", step, i);
+   }
+   else
+   {
+      x86_emit("mov (%%rsp),%%rax");
+      x86_emit("add %%rax,%s", i);
+   }
+   x86_emit("jmp .L%d", test);
+   x86_label(exit);
+   x86_emit("add $16,%%rsp");
+   x86_scope = scope;
+}
+
+static void x86_stmt(Node *node)
+{
+   switch (node->nodeType)
+   {
+   case CompoundNT:
+      x86_compound(node);
+      break;
+   case IfNT:
+      x86_if(node);
+      break;
+   case IterNT:
+      x86_while(node);
+      break;
+   case ToNT:
+      x86_for(node);
+      break;
+   case ReturnNT:
+      if (node->child[0] != NULL)
+         x86_expr(node->child[0]);
+      x86_emit("jmp .L%d", x86_return);
+      break;
+   case BreakNT:
+      if (!x86_breaks.empty())
+         x86_emit("jmp .L%d", x86_breaks.back());
+      break;
+   case VarNT:
+   case VarArrNT:
+   case StaticNT:
+      break;
+   default:
+      x86_expr(node);
+      break;
+   }
+}
+
+static void x86_stmts(Node *node)
+{
+   for (; node != NULL; node = node->sibling)
+      x86_stmt(node);
+}
+
+/* ==================================================
+   FUNCTIONS
+   ================================================== */
+// The caller stored its fp at 0 of the new frame and made it the frame;
+// the machine stack frame drops temporaries a return leaves behind.
+static void x86_function(Node *func)
+{
+   fprintf(code, "\n# FUNCTION %s\n", func->literal);
+   fprintf(code, "%s:\n", x86_func_name(func->literal).c_str());
+   x86_emit("push %%rbp");
+   x86_emit("mov %%rsp,%%rbp");
+   x86_emit("lea cm_limit(%%rip),%%rcx");
+   x86_emit("cmp %%rcx,%%rbx");
+   x86_emit("jb rt_overflow");
+   x86_return = x86_new_label();
+   x86_scope = func->size;
+   x86_stmts(func->child[1]);
+   x86_emit("xor %%eax,%%eax");
+   x86_label(x86_return);
+   x86_emit("leave");
+   x86_emit("mov (%%rbx),%%rbx");
+   x86_emit("ret");
+}
+
+/* ==================================================
+   DATA
+   ================================================== */
+static void x86_collect(Node *node)
+{
+   for (; node != NULL; node = node->sibling)
+   {
+      if (node->isLib)
+         continue;
+      if (node->is_decl && (node->refType == GlobalRT || node->refType == StaticRT) &&
+          (node->nodeType == VarNT || node->nodeType == VarArrNT || node->nodeType == StaticNT))
+         x86_globals.push_back(node);
+      if (node->nodeType == StringConstNT)
+         x86_strings.push_back(node);
+      for (int i = 0; i < MAXCHILDREN; i++)
+         x86_collect(node->child[i]);
+   }
+}
+
+// Initial image of the global space: array sizes and string constants.
+static void x86_data()
+{
+   int words = goffset < 0 ? -goffset : 1;
+   vector<long long> image(words, 0);
+   for (size_t n = 0; n < x86_globals.size(); n++)
+   {
+      Node *decl = x86_globals[n];
+      if (decl->isArray && -(decl->location + 1) >= 0 && -(decl->location + 1) < words)
+         image[-(decl->location + 1)] = decl->size - 1;
+   }
+   for (size_t n = 0; n < x86_strings.size(); n++)
+   {
+      Node *str = x86_strings[n];
+      string text = str->data.String;
+      if (text.size() >= 2)
+         text = text.substr(1, text.size() - 2);
+      int top = -(str->location + 1);
+      if (top < 0 || top + (int)text.size() >= words)
+         continue;
+      image[top] = text.size();
+      for (size_t k = 0; k < text.size(); k++)
+         image[top + 1 + k] = (unsigned char)text[k];
+   }
+
+   fprintf(code, "\n\t.data\n\t.balign 8\n");
+   fprintf(code, "# globals and statics (location 0 at cm_gp)\n");
+   for (int w = words - 1; w >= 0; w--)
+   {
+      if (w == 0)
+         fprintf(code, "cm_gp:\n");
+      int zeros = 0;
+      while (w - zeros >= 1 && image[w - zeros] == 0)
+         zeros++;
+      if (zeros > 1)
+      {
+         x86_emit(".zero %d", 8 * zeros);
+         w -= zeros - 1;
+      }
+      else
+      {
+         x86_emit(".quad %lld", image[w]);
+      }
+   }
+   fprintf(code, "\n\t.bss\n\t.balign 16\n");
+   fprintf(code, "cm_stack:\n");
+   x86_emit(".zero %d", 8 * X86_STACK_WORDS);
+   x86_emit(".set cm_frame, cm_stack+%d", 8 * (X86_STACK_WORDS - 1));
+   x86_emit(".set cm_limit, cm_stack+%d", 8 * (1 - x86_floor));
+   x86_emit(".section .note.GNU-stack,\"\",@progbits");
+}
+
+/* ==================================================
+   GENERATE X86-64
+   ================================================== */
+void generate_x86(Node *AST)
+{
+   Node *main_func = NULL;
+   for (Node *itr = AST; itr != NULL; itr = itr->sibling)
+   {
+      if (itr->nodeType != FuncNT)
+         continue;
+      x86_funcs[itr->literal] = itr;
+      if (itr->isMain)
+         main_func = itr;
+   }
+   x86_collect(AST);
+
+   fprintf(code, "# C- compiler x86-64 code\n\t.text\n");
+   for (Node *itr = AST; itr != NULL; itr = itr->sibling)
+      if (itr->nodeType == FuncNT && !itr->isLib)
+         x86_function(itr);
+
+   fprintf(code, "\n# INIT\n\t.globl main\nmain:\n");
+   x86_emit("push %%rbx");
+   x86_emit("push %%rbp");
+   x86_emit("mov %%rsp,%%rbp");
+   x86_emit("and $-16,%%rsp");
+   x86_emit("mov $1,%%edi");
+   x86_emit("call srand@PLT");
+   x86_emit("lea cm_frame(%%rip),%%rbx");
+   x86_emit("mov %%rbx,(%%rbx)");
+   x86_scope = -2;
+   for (size_t n = 0; n < x86_globals.size(); n++)
+   {
+      Node *decl = x86_globals[n];
+      if (decl->child[0] == NULL)
+         continue;
+      x86_expr(decl->child[0]);
+      if (decl->isArray)
+      {
+         x86_emit("mov %%rax,%%rsi");
+         x86_array_base(decl, "%rdi");
+         x86_emit("call rt_copy");
+      }
+      else
+      {
+         x86_emit("mov %%rax,%s", x86_slot(decl->location, decl->refType).c_str());
+      }
+   }
+   if (main_func != NULL)
+      x86_emit("call %s", x86_func_name(main_func->literal).c_str());
+   x86_emit("mov %%rbp,%%rsp");
+   x86_emit("pop %%rbp");
+   x86_emit("pop %%rbx");
+   x86_emit("xor %%eax,%%eax");
+   x86_emit("ret");
+   fprintf(code, "\n# RUNTIME\n");
+   for (int n = 0; runtime[n] != NULL; n++)
+      fprintf(code, "%s\n", runtime[n]);
+   x86_data();
+   fflush(code);
+}
@@ -0,0 +1,22 @@
+#ifndef _CODE_GEN_X86_H
+#define _CODE_GEN_X86_H
+
+#include "AST.hpp"
+
+/* ==================================================
+   X86-64 CODE GENERATOR
+   - Walks the annotated AST (the location, refType and size fields of
+     the semantic analysis) and writes GNU assembler x86-64 code instead
+     of TM code, with a small runtime for the I/O routines, so
+     "cc prog.s" links a native executable.
+   - Frames keep the TM layout on a data stack of their own (%rbx is the
+     frame pointer): old fp at 0, parameters from -2, locals below. Globals
+     and statics are 8-byte words below cm_gp, arrays grow down from their
+     base with the size one word above it, as in TM data memory.
+   - Expression temporaries and the stop/step values of for loops live on
+     the machine stack.
+   ================================================== */
+
+void generate_x86(Node *AST);
+
+#endif
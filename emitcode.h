@@ -1,51 +1,84 @@
-#ifndef EMIT_CODE_H__
-#define EMIT_CODE_H__
-
-//
-//  REGISTER DEFINES for optional use in calling the
-//  routines below.
-//
-#define GP 0  //  The global pointer
-#define FP 1  //  The local frame pointer
-#define RT 2  //  Return value
-#define AC 3  //  Accumulator
-#define AC1 4 //  Accumulator
-#define AC2 5 //  Accumulator
-#define AC3 6 //  Accumulator
-#define PC 7  //  The program counter
-
-//
-//  No comment please...
-//
-#define NO_COMMENT (char *)""
-
-//
-//  The following functions were borrowed from Tiny compiler code generator
-//
-int emitWhereAmI();        // gives where the next instruction will be placed
-int emitSkip(int howMany); // emitSkip(0) tells you where the next instruction will be placed
-void emitNewLoc(int loc);  // set the instruction counter back to loc
-
-void emitComment(char *c);
-void emitComment(char *c, char *cc);
-void emitComment(char *c, int n);
-
-void emitGoto(int d, long long int s, char *c);
-void emitGoto(int d, long long int s, char *c, char *cc);
-void emitGotoAbs(int a, char *c);
-void emitGotoAbs(int a, char *c, char *cc);
-
-void emitRM(char *op, long long int r, long long int d, long long int s, char *c);
-void emitRM(char *op, long long int r, long long int d, long long int s, char *c, char *cc);
-void emitRMAbs(char *op, long long int r, long long int a, char *c);
-void emitRMAbs(char *op, long long int r, long long int a, char *c, char *cc);
-
-void emitRO(char *op, long long int r, long long int s, long long int t, char *c);
-void emitRO(char *op, long long int r, long long int s, long long int t, char *c, char *cc);
-
-void backPatchAJumpToHere(int addr, char *comment);
-void backPatchAJumpToHere(char *cmd, int reg, int addr, char *comment);
-
-int emitStrLit(int goffset, char *s); // for char arrays
-
+#ifndef EMIT_CODE_H__
+#define EMIT_CODE_H__
+
+#include <string>
+#include <vector>
+
+//
+//  REGISTER DEFINES for optional use in calling the
+//  routines below.
+//
+#define GP 0  //  The global pointer
+#define FP 1  //  The local frame pointer
+#define RT 2  //  Return value
+#define AC 3  //  Accumulator
+#define AC1 4 //  Accumulator
+#define AC2 5 //  Accumulator
+#define AC3 6 //  Accumulator
+#define PC 7  //  The program counter
+
+//
+//  No comment please...
+//
+#define NO_COMMENT (char *)""
+
+//
+//  The following functions were borrowed from Tiny compiler code generator
+//
+int emitWhereAmI();        // gives where the next instruction will be placed
+int emitSkip(int howMany); // emitSkip(0) tells you where the next instruction will be placed
+void emitNewLoc(int loc);  // set the instruction counter back to loc
+
+void emitComment(char *c);
+void emitComment(char *c, char *cc);
+void emitComment(char *c, int n);
+
+void emitGoto(int d, long long int s, char *c);
+void emitGoto(int d, long long int s, char *c, char *cc);
+void emitGotoAbs(int a, char *c);
+void emitGotoAbs(int a, char *c, char *cc);
+
+void emitRM(char *op, long long int r, long long int d, long long int s, char *c);
+void emitRM(char *op, long long int r, long long int d, long long int s, char *c, char *cc);
+void emitRMAbs(char *op, long long int r, long long int a, char *c);
+void emitRMAbs(char *op, long long int r, long long int a, char *c, char *cc);
+
+void emitRO(char *op, long long int r, long long int s, long long int t, char *c);
+void emitRO(char *op, long long int r, long long int s, long long int t, char *c, char *cc);
+
+void backPatchAJumpToHere(int addr, char *comment);
+void backPatchAJumpToHere(char *cmd, int reg, int addr, char *comment);
+
+int emitStrLit(int goffset, char *s); // for char arrays
+
+//
+//  Buffered emission: while buffering is on, lines are kept in memory
+//  instead of being printed so a pass can rewrite the program first.
+//
+struct TMLine
+{
+   bool isInstr;           // false: comment or LIT line, printed verbatim from text
+   int loc;                // instruction address
+   bool isRO;              // register-only instruction (r,s,t) else r,d(s)
+   std::string op;         // opcode
+   long long int r, d, s;  // for RO instructions d and s hold s and t
+   std::string text;       // instruction comment, or the whole line
+   int lineNum;            // C- source line of the instruction (0: none)
+   const char *func;       // enclosing C- function (NULL: none)
+};
+
+void emitBuffer(bool on);              // start/stop buffering
+std::vector<TMLine> &emitBuffered();   // the buffered lines in emission order
+void emitFlush();                      // print and clear the buffered lines
+
+//
+//  Source positions: every instruction is tagged with the C- line and
+//  function current when it is emitted, or when its location was skipped
+//  for a backpatch. emitLineTable writes the tags of the printed code.
+//
+void emitSource(int lineNum, const char *func); // tag the next instructions
+int emitSourceLine();
+const char *emitSourceFunc();
+bool emitLineTable(const char *file, const char *tmFile);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,1177 @@
+#include "optimize.hpp"
+#include "profile.hpp"
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <deque>
+#include <limits.h>
+
+using namespace std;
+
+#define SPEC_BUDGET 600   // Max AST nodes added by function clones in total.
+#define SPEC_MAX_CLONES 4 // Max clones of a single function.
+
+/* ==================================================
+   TREE HELPERS
+   ================================================== */
+// Deep copy of a subtree, siblings included.
+Node *copy_tree(Node *node)
+{
+   if (node == NULL)
+      return NULL;
+   Node *t = new Node();
+   *t = *node;
+   for (int i = 0; i < MAXCHILDREN; i++)
+      t->child[i] = copy_tree(node->child[i]);
+   t->sibling = copy_tree(node->sibling);
+   return t;
+}
+
+// Number of nodes in the subtree (siblings included).
+int count_tree(Node *node)
+{
+   int n = 0;
+   for (; node != NULL; node = node->sibling)
+   {
+      n++;
+      for (int i = 0; i < MAXCHILDREN; i++)
+         n += count_tree(node->child[i]);
+   }
+   return n;
+}
+
+// Is the scalar variable name assigned (=, +=, ++, ...) anywhere in the subtree?
+bool writes_var(Node *node, char *name)
+{
+   for (; node != NULL; node = node->sibling)
+   {
+      if (node->nodeType == AssignNT && node->child[0] != NULL && node->child[0]->nodeType == IdNT &&
+          strcmp(node->child[0]->literal, name) == 0)
+         return true;
+      for (int i = 0; i < MAXCHILDREN; i++)
+         if (writes_var(node->child[i], name))
+            return true;
+   }
+   return false;
+}
+
+// Is a variable called name declared (and so possibly shadowed) in the subtree?
+bool declares_var(Node *node, char *name)
+{
+   for (; node != NULL; node = node->sibling)
+   {
+      if ((node->nodeType == VarNT || node->nodeType == VarArrNT || node->nodeType == StaticNT) &&
+          node->literal != NULL && strcmp(node->literal, name) == 0)
+         return true;
+      for (int i = 0; i < MAXCHILDREN; i++)
+         if (declares_var(node->child[i], name))
+            return true;
+   }
+   return false;
+}
+
+static bool has_static(Node *node)
+{
+   for (; node != NULL; node = node->sibling)
+   {
+      if (node->isStatic || node->nodeType == StaticNT)
+         return true;
+      for (int i = 0; i < MAXCHILDREN; i++)
+         if (has_static(node->child[i]))
+            return true;
+   }
+   return false;
+}
+
+static bool has_loop_or_decl(Node *node)
+{
+   for (; node != NULL; node = node->sibling)
+   {
+      if (node->is_decl || node->nodeType == ToNT || node->nodeType == IterNT)
+         return true;
+      for (int i = 0; i < MAXCHILDREN; i++)
+         if (has_loop_or_decl(node->child[i]))
+            return true;
+   }
+   return false;
+}
+
+/* ==================================================
+   CONSTANTS
+   ================================================== */
+bool is_const_node(Node *node)
+{
+   return node != NULL && node->isConst &&
+          (node->nodeType == NumConstNT || node->nodeType == BoolConstNT || node->nodeType == CharConstNT);
+}
+
+// Builds a constant node of the given type; it takes the place of like.
+Node *make_const(DataType type, int value, Node *like)
+{
+   char buf[32];
+   Node *t = createNode(NULL, type == BoolDT ? BoolConstNT : type == CharDT ? CharConstNT : NumConstNT);
+   t->dataType = type;
+   t->isConst = true;
+   t->isInit = true;
+   t->lineNum = like != NULL ? like->lineNum : -1;
+   switch (type)
+   {
+   case BoolDT:
+      t->tknClass = BOOLCONST;
+      t->data.Int = value != 0;
+      sprintf(buf, "%s", value ? "true" : "false");
+      break;
+   case CharDT:
+      t->tknClass = CHARCONST;
+      t->data.Char = (char)value;
+      sprintf(buf, "'%c'", (char)value);
+      break;
+   default:
+      t->tknClass = NUMCONST;
+      t->data.Int = value;
+      sprintf(buf, "%d", value);
+      break;
+   }
+   t->literal = strdup(buf);
+   if (like != NULL)
+      t->sibling = like->sibling;
+   return t;
+}
+
+// s % t as the TM computes it: a negative remainder gets |t| added, so
+// -17 % 5 is 3 where C gives -2. t is not 0.
+static long long tm_mod(long long s, long long t)
+{
+   long long r = s % t;
+   return r < 0 ? r + (t < 0 ? -t : t) : r;
+}
+
+// Value of an expression built only from constants (bools are 0/1). The TM
+// computes in 64 bits while constants are ints, so the operations are done
+// in long long and an expression with a value outside the int range anywhere
+// (100000 * 100000, -(-2147483647 - 1), INT_MIN / -1) is not folded.
+static bool const_wide(Node *node, long long *value)
+{
+   long long lhs, rhs;
+   if (node == NULL)
+      return false;
+   switch (node->nodeType)
+   {
+   case NumConstNT:
+   case BoolConstNT:
+      *value = node->data.Int;
+      return true;
+   case CharConstNT:
+      *value = node->data.Char;
+      return true;
+   case SignNT:
+      if (node->tknClass != SUB || !const_wide(node->child[0], &lhs))
+         return false;
+      *value = -lhs;
+      break;
+   case NotNT:
+      if (!const_wide(node->child[0], &lhs))
+         return false;
+      *value = !lhs;
+      return true;
+   case AndNT:
+   case OrNT:
+      if (!const_wide(node->child[0], &lhs) || !const_wide(node->child[1], &rhs))
+         return false;
+      *value = node->nodeType == AndNT ? (lhs && rhs) : (lhs || rhs);
+      return true;
+   case OpNT:
+      if (!const_wide(node->child[0], &lhs) || !const_wide(node->child[1], &rhs))
+         return false;
+      switch (node->tknClass)
+      {
+      case ADD:
+         *value = lhs + rhs;
+         break;
+      case SUB:
+         *value = lhs - rhs;
+         break;
+      case MUL:
+         *value = lhs * rhs;
+         break;
+      case DIV:
+         if (rhs == 0 || (lhs == INT_MIN && rhs == -1))
+            return false;
+         *value = lhs / rhs;
+         break;
+      case MOD:
+         if (rhs == 0 || (lhs == INT_MIN && rhs == -1))
+            return false;
+         *value = tm_mod(lhs, rhs);
+         break;
+      case EQL:
+         *value = lhs == rhs;
+         return true;
+      case NEQ:
+         *value = lhs != rhs;
+         return true;
+      case LESS:
+         *value = lhs < rhs;
+         return true;
+      case LEQ:
+         *value = lhs <= rhs;
+         return true;
+      case GREAT:
+         *value = lhs > rhs;
+         return true;
+      case GEQ:
+         *value = lhs >= rhs;
+         return true;
+      default:
+         return false;
+      }
+      break;
+   default:
+      return false;
+   }
+   return *value >= INT_MIN && *value <= INT_MAX;
+}
+
+bool eval_const(Node *node, int *value)
+{
+   long long wide;
+   if (!const_wide(node, &wide))
+      return false;
+   *value = (int)wide;
+   return true;
+}
+
+/* ==================================================
+   CONSTANT FOLDING
+   ================================================== */
+// Folds constant subexpressions of node (and its siblings). Returns the node
+// to put in its place.
+Node *fold_expr(Node *node)
+{
+   if (node == NULL)
+      return NULL;
+   node->sibling = fold_expr(node->sibling);
+   switch (node->nodeType)
+   {
+   case OpNT:
+   case SignNT:
+   case NotNT:
+   case AndNT:
+   case OrNT:
+   {
+      for (int i = 0; i < MAXCHILDREN; i++)
+         node->child[i] = fold_expr(node->child[i]);
+      int value;
+      if (!node->isArray && eval_const(node, &value))
+         return make_const(node->dataType, value, node);
+      return node;
+   }
+   case CallNT:
+   case ArrNT:
+   case AssignNT:
+   case ReturnNT:
+   case SizeOfNT:
+   case QuesNT:
+      for (int i = 0; i < MAXCHILDREN; i++)
+         node->child[i] = fold_expr(node->child[i]);
+      return node;
+   default:
+      return node;
+   }
+}
+
+// A statement that is the whole body of an if/while/for must not vanish.
+static Node *fold_branch(Node *node)
+{
+   Node *folded = fold_stmts(node);
+   return folded != NULL ? folded : node;
+}
+
+// Folds the expressions of a statement list and drops branches that can
+// never run. Returns the new head of the list.
+Node *fold_stmts(Node *node)
+{
+   if (node == NULL)
+      return NULL;
+   node->sibling = fold_stmts(node->sibling);
+   int value;
+   switch (node->nodeType)
+   {
+   case CompoundNT:
+      node->child[1] = fold_stmts(node->child[1]);
+      return node;
+   case IfNT:
+      node->child[0] = fold_expr(node->child[0]);
+      node->child[1] = fold_branch(node->child[1]);
+      node->child[2] = fold_branch(node->child[2]);
+      if (eval_const(node->child[0], &value))
+      {
+         Node *taken = value ? node->child[1] : node->child[2];
+         if (taken != NULL && (taken->sibling != NULL || has_loop_or_decl(taken)))
+            return node;
+         if (taken == NULL)
+            return node->sibling;
+         taken->sibling = node->sibling;
+         return taken;
+      }
+      return node;
+   case IterNT:
+      node->child[0] = fold_expr(node->child[0]);
+      node->child[1] = fold_branch(node->child[1]);
+      if (eval_const(node->child[0], &value) && !value)
+         return node->sibling;
+      return node;
+   case ToNT:
+      node->child[1]->child[0] = fold_expr(node->child[1]->child[0]);
+      node->child[1]->child[1] = fold_expr(node->child[1]->child[1]);
+      node->child[1]->child[2] = fold_expr(node->child[1]->child[2]);
+      node->child[2] = fold_branch(node->child[2]);
+      return node;
+   case ReturnNT:
+   case AssignNT:
+   case CallNT:
+   case OpNT:
+   case SignNT:
+   case NotNT:
+   case AndNT:
+   case OrNT:
+   case ArrNT:
+   {
+      Node *sibling = node->sibling;
+      node->sibling = NULL;
+      Node *folded = fold_expr(node);
+      folded->sibling = sibling;
+      return folded;
+   }
+   default:
+      return node;
+   }
+}
+
+/* ==================================================
+   FUNCTION SPECIALIZATION
+   ================================================== */
+// Call sites of user functions that pass constants for parameters the callee
+// never assigns are grouped by (function, constant arguments). Each group
+// gets a clone of the function with those parameters replaced by the
+// constants and folded; the calls are redirected to it. The parameters are
+// still passed, so the frame layout of the clone is the same as the original.
+
+struct SpecCall
+{
+   Node *call;
+   int caller; // position of the calling function in the program
+};
+
+struct SpecGroup
+{
+   Node *func;
+   int funcPos;
+   vector<int> parm;  // parameter indexes bound to constants
+   vector<int> value; // their values
+   vector<SpecCall> calls;
+};
+
+static void collect_calls(Node *node, int caller, vector<SpecCall> &calls)
+{
+   for (; node != NULL; node = node->sibling)
+   {
+      if (node->nodeType == CallNT)
+      {
+         SpecCall c;
+         c.call = node;
+         c.caller = caller;
+         calls.push_back(c);
+      }
+      for (int i = 0; i < MAXCHILDREN; i++)
+         collect_calls(node->child[i], caller, calls);
+   }
+}
+
+static void bind_parm(Node *node, char *name, DataType type, int value)
+{
+   for (; node != NULL; node = node->sibling)
+   {
+      for (int i = 0; i < MAXCHILDREN; i++)
+      {
+         Node *c = node->child[i];
+         if (c != NULL && c->nodeType == IdNT && !c->isArray && strcmp(c->literal, name) == 0)
+            node->child[i] = make_const(type, value, c);
+         bind_parm(node->child[i], name, type, value);
+      }
+      Node *s = node->sibling;
+      if (s != NULL && s->nodeType == IdNT && !s->isArray && strcmp(s->literal, name) == 0)
+         node->sibling = make_const(type, value, s);
+   }
+}
+
+int specialize_functions(Node *AST)
+{
+   vector<Node *> funcs;
+   for (Node *itr = AST; itr != NULL; itr = itr->sibling)
+      if (itr->nodeType == FuncNT)
+         funcs.push_back(itr);
+
+   vector<SpecCall> calls;
+   for (size_t f = 0; f < funcs.size(); f++)
+      if (!funcs[f]->isLib)
+         collect_calls(funcs[f]->child[1], f, calls);
+
+   // Group the calls by callee and constant arguments.
+   map<string, SpecGroup> groups;
+   vector<string> order;
+   for (size_t c = 0; c < calls.size(); c++)
+   {
+      Node *call = calls[c].call;
+      int pos = -1;
+      for (size_t f = 0; f < funcs.size(); f++)
+         if (strcmp(funcs[f]->literal, call->literal) == 0)
+            pos = f;
+      // The clone goes right after the callee, so callers must come later.
+      if (pos < 0 || funcs[pos]->isLib || funcs[pos]->isMain || calls[c].caller <= pos)
+         continue;
+      Node *func = funcs[pos];
+      if (has_static(func->child[1]))
+         continue;
+
+      SpecGroup g;
+      g.func = func;
+      g.funcPos = pos;
+      string key = func->literal;
+      Node *parm = func->child[0];
+      Node *arg = call->child[0];
+      for (int k = 0; parm != NULL && arg != NULL; k++, parm = parm->sibling, arg = arg->sibling)
+      {
+         int value;
+         if (parm->nodeType != ParmNT || parm->isArray || !eval_const(arg, &value) ||
+             writes_var(func->child[1], parm->literal) || declares_var(func->child[1], parm->literal))
+            continue;
+         g.parm.push_back(k);
+         g.value.push_back(value);
+         key += "|" + to_string(k) + "=" + to_string(value);
+      }
+      if (g.parm.empty())
+         continue;
+      if (groups.find(key) == groups.end())
+      {
+         groups[key] = g;
+         order.push_back(key);
+      }
+      groups[key].calls.push_back(calls[c]);
+   }
+
+   // Hottest combinations first: by executed calls with a profile, else by
+   // number of call sites. Calls the profile never saw run are not cloned for.
+   map<string, long long> heat;
+   for (size_t i = 0; i < order.size(); i++)
+   {
+      SpecGroup &g = groups[order[i]];
+      heat[order[i]] = g.calls.size();
+      if (!profile_loaded())
+         continue;
+      long long runs = 0;
+      for (size_t c = 0; c < g.calls.size(); c++)
+      {
+         Node *call = g.calls[c].call;
+         long long n = profile_count("call", funcs[g.calls[c].caller]->literal, call->lineNum, call->literal);
+         runs += n == PROFILE_UNKNOWN ? 1 : n;
+      }
+      heat[order[i]] = runs;
+   }
+   for (size_t i = 0; i < order.size(); i++)
+      for (size_t j = i + 1; j < order.size(); j++)
+         if (heat[order[j]] > heat[order[i]])
+            swap(order[i], order[j]);
+
+   int budget = SPEC_BUDGET;
+   int clones = 0;
+   map<Node *, int> cloneCount;
+   for (size_t i = 0; i < order.size(); i++)
+   {
+      SpecGroup &g = groups[order[i]];
+      if (cloneCount[g.func] >= SPEC_MAX_CLONES || heat[order[i]] == 0)
+         continue;
+      Node *body = copy_tree(g.func->child[1]);
+      int before = count_tree(body);
+      if (before > budget)
+         continue;
+      for (size_t k = 0; k < g.parm.size(); k++)
+      {
+         Node *parm = g.func->child[0];
+         for (int n = 0; n < g.parm[k]; n++)
+            parm = parm->sibling;
+         bind_parm(body, parm->literal, parm->dataType, g.value[k]);
+      }
+      body = fold_stmts(body);
+      // Only keep clones the constants actually simplified.
+      if (body == NULL || count_tree(body) >= before)
+         continue;
+
+      char name[64];
+      snprintf(name, sizeof(name), "%s-SP%d", g.func->literal, ++cloneCount[g.func]);
+      Node *clone = new Node();
+      *clone = *g.func;
+      clone->literal = strdup(name);
+      clone->child[0] = copy_tree(g.func->child[0]);
+      clone->child[1] = body;
+      clone->sibling = g.func->sibling;
+      g.func->sibling = clone;
+      for (size_t c = 0; c < g.calls.size(); c++)
+         g.calls[c].call->literal = strdup(name);
+      budget -= count_tree(body);
+      clones++;
+   }
+   return clones;
+}
+
+/* ==================================================
+   ALGEBRAIC SIMPLIFICATION
+   ================================================== */
+// Can the expression be dropped or computed once instead of twice? Calls,
+// assignments and ? (random numbers) have side effects.
+bool is_pure(Node *node)
+{
+   if (node == NULL)
+      return true;
+   if (node->nodeType == CallNT || node->nodeType == AssignNT || node->nodeType == QuesNT)
+      return false;
+   for (int i = 0; i < MAXCHILDREN; i++)
+      if (!is_pure(node->child[i]))
+         return false;
+   return true;
+}
+
+// Do a and b compute the same value (same operators, variables and constants)?
+bool same_expr(Node *a, Node *b)
+{
+   if (a == NULL || b == NULL)
+      return a == b;
+   if (a->nodeType != b->nodeType || a->tknClass != b->tknClass || a->isArray || b->isArray)
+      return false;
+   int x, y;
+   if (is_const_node(a))
+      return eval_const(a, &x) && eval_const(b, &y) && x == y;
+   if (a->nodeType == IdNT && strcmp(a->literal, b->literal) != 0)
+      return false;
+   for (int i = 0; i < MAXCHILDREN; i++)
+      if (!same_expr(a->child[i], b->child[i]))
+         return false;
+   return true;
+}
+
+// The code generators load constants and scalar variables wherever an
+// expression may appear; any other node only takes the place of its own kind.
+static Node *replace(Node *repl, Node *node, int *changes)
+{
+   if (repl->nodeType != node->nodeType && !is_const_node(repl) && (repl->nodeType != IdNT || repl->isArray))
+      return node;
+   repl->sibling = node->sibling;
+   (*changes)++;
+   return repl;
+}
+
+// The operands of node are dropped, so they must be pure.
+static Node *replace_const(int value, Node *node, int *changes)
+{
+   (*changes)++;
+   return make_const(node->dataType, value, node);
+}
+
+// Identities of +, -, *, /, %, comparisons, unary -, not, and, or.
+static Node *simplify_op(Node *node, int *changes)
+{
+   Node *lhs = node->child[0];
+   Node *rhs = node->child[1];
+   int l, r;
+   bool lc = lhs != NULL && eval_const(lhs, &l);
+   bool rc = rhs != NULL && eval_const(rhs, &r);
+   switch (node->nodeType)
+   {
+   case OpNT:
+      if (node->isArray || lhs->isArray || rhs->isArray)
+         return node;
+      switch (node->tknClass)
+      {
+      case ADD:
+         if (rc && r == 0)
+            return replace(lhs, node, changes);
+         if (lc && l == 0)
+            return replace(rhs, node, changes);
+         break;
+      case SUB:
+         if (rc && r == 0)
+            return replace(lhs, node, changes);
+         if (same_expr(lhs, rhs) && is_pure(lhs))
+            return replace_const(0, node, changes);
+         break;
+      case MUL:
+         if (rc && r == 1)
+            return replace(lhs, node, changes);
+         if (lc && l == 1)
+            return replace(rhs, node, changes);
+         if ((rc && r == 0 && is_pure(lhs)) || (lc && l == 0 && is_pure(rhs)))
+            return replace_const(0, node, changes);
+         break;
+      case DIV:
+         if (rc && r == 1)
+            return replace(lhs, node, changes);
+         break;
+      case MOD:
+         if (rc && (r == 1 || r == -1) && is_pure(lhs))
+            return replace_const(0, node, changes);
+         break;
+      case EQL:
+      case LEQ:
+      case GEQ:
+         if (same_expr(lhs, rhs) && is_pure(lhs))
+            return replace_const(1, node, changes);
+         break;
+      case NEQ:
+      case LESS:
+      case GREAT:
+         if (same_expr(lhs, rhs) && is_pure(lhs))
+            return replace_const(0, node, changes);
+         break;
+      }
+      return node;
+   case SignNT:
+      // - - x is x
+      if (node->tknClass == SUB && lhs->nodeType == SignNT && lhs->tknClass == SUB)
+         return replace(lhs->child[0], node, changes);
+      return node;
+   case NotNT:
+      // Booleans are 0 or 1, so not not b is b.
+      if (lhs->nodeType == NotNT)
+         return replace(lhs->child[0], node, changes);
+      return node;
+   case AndNT:
+   case OrNT:
+   {
+      // and/or evaluate both sides, so a side can only go if it is pure.
+      int unit = node->nodeType == AndNT ? 1 : 0;
+      if (rc && r == unit)
+         return replace(lhs, node, changes);
+      if (lc && l == unit)
+         return replace(rhs, node, changes);
+      if ((rc && r != unit && is_pure(lhs)) || (lc && l != unit && is_pure(rhs)))
+         return replace_const(!unit, node, changes);
+      return node;
+   }
+   default:
+      return node;
+   }
+}
+
+// Folds constants and applies the identities bottom-up in the subtree rooted
+// at node (siblings included). Returns the node to put in its place.
+static Node *simplify(Node *node, int *changes)
+{
+   if (node == NULL)
+      return NULL;
+   node->sibling = simplify(node->sibling, changes);
+   for (int i = 0; i < MAXCHILDREN; i++)
+      node->child[i] = simplify(node->child[i], changes);
+   switch (node->nodeType)
+   {
+   case OpNT:
+   case SignNT:
+   case NotNT:
+   case AndNT:
+   case OrNT:
+   {
+      int value;
+      if (!node->isArray && eval_const(node, &value))
+         return replace_const(value, node, changes);
+      return simplify_op(node, changes);
+   }
+   default:
+      return node;
+   }
+}
+
+int simplify_expressions(Node *AST)
+{
+   int changes = 0;
+   for (Node *itr = AST; itr != NULL; itr = itr->sibling)
+      if (itr->nodeType == FuncNT && !itr->isLib)
+         itr->child[1] = simplify(itr->child[1], &changes);
+   return changes;
+}
+
+/* ==================================================
+   COMPILE-TIME EVALUATION
+   ================================================== */
+// A small interpreter for the C- AST. A call with constant arguments is run
+// at compile time; if it finishes without touching anything outside its own
+// frames (globals, statics, I/O, random numbers, strings) it is pure and the
+// call is replaced by its result. Every statement and expression costs one
+// step, so evaluation always stops.
+
+#define EVAL_STEPS 100000  // Max steps for one compile-time call.
+#define EVAL_TOTAL 2000000 // Max steps for the whole program.
+#define EVAL_DEPTH 200     // Max call depth inside the interpreter.
+#define EVAL_UNDEF LLONG_MIN
+
+enum EvalStatus
+{
+   EV_NEXT,
+   EV_BREAK,
+   EV_RETURN,
+   EV_FAIL
+};
+
+struct EvalVar
+{
+   vector<long long> *cells;
+   bool isArray;
+};
+
+struct Eval
+{
+   map<string, Node *> funcs;
+   vector<map<string, EvalVar> > scopes; // innermost last
+   size_t frame;                         // first scope of the running function
+   deque<vector<long long> > store;      // storage of every variable
+   long long retval;
+   int steps;
+   int depth;
+};
+
+static bool ev_expr(Eval &e, Node *node, long long *value);
+static EvalStatus ev_stmts(Eval &e, Node *node);
+static bool ev_call(Eval &e, Node *call, long long *value);
+
+static bool ev_step(Eval &e)
+{
+   return ++e.steps <= EVAL_STEPS;
+}
+
+static bool ev_int(long long value)
+{
+   return value >= INT_MIN && value <= INT_MAX;
+}
+
+// Variables of the running function only; a miss is a global.
+static EvalVar *ev_lookup(Eval &e, char *name)
+{
+   for (size_t s = e.scopes.size(); s > e.frame; s--)
+   {
+      map<string, EvalVar>::iterator it = e.scopes[s - 1].find(name);
+      if (it != e.scopes[s - 1].end())
+         return &it->second;
+   }
+   return NULL;
+}
+
+static EvalVar *ev_declare(Eval &e, char *name, int length, bool isArray)
+{
+   e.store.push_back(vector<long long>(length, EVAL_UNDEF));
+   EvalVar var;
+   var.cells = &e.store.back();
+   var.isArray = isArray;
+   e.scopes.back()[name] = var;
+   return &e.scopes.back()[name];
+}
+
+// Address of the scalar or array element named by node.
+static long long *ev_lvalue(Eval &e, Node *node)
+{
+   if (node->nodeType == IdNT)
+   {
+      EvalVar *var = ev_lookup(e, node->literal);
+      if (var == NULL || var->isArray || node->isStatic)
+         return NULL;
+      return &(*var->cells)[0];
+   }
+   if (node->nodeType == ArrNT)
+   {
+      EvalVar *var = ev_lookup(e, node->child[0]->literal);
+      long long index;
+      if (var == NULL || !var->isArray || !ev_expr(e, node->child[1], &index))
+         return NULL;
+      if (index < 0 || index >= (long long)var->cells->size())
+         return NULL;
+      return &(*var->cells)[index];
+   }
+   return NULL;
+}
+
+static bool ev_assign(Eval &e, Node *node, long long *value)
+{
+   long long *cell = ev_lvalue(e, node->child[0]);
+   long long rhs = 1;
+   if (cell == NULL)
+      return false;
+   if (node->tknClass != INC && node->tknClass != DEC && !ev_expr(e, node->child[1], &rhs))
+      return false;
+   if (node->tknClass != ASGN && *cell == EVAL_UNDEF)
+      return false;
+   switch (node->tknClass)
+   {
+   case ASGN:
+      *value = rhs;
+      break;
+   case ADDASS:
+   case INC:
+      *value = *cell + rhs;
+      break;
+   case SUBASS:
+   case DEC:
+      *value = *cell - rhs;
+      break;
+   case MULASS:
+      *value = *cell * rhs;
+      break;
+   case DIVASS:
+      if (rhs == 0)
+         return false;
+      *value = *cell / rhs;
+      break;
+   default:
+      return false;
+   }
+   if (!ev_int(*value))
+      return false;
+   *cell = *value;
+   return true;
+}
+
+// Operands the generated code compares as whole arrays.
+static bool ev_string_operand(Node *node)
+{
+   return node->isArray && (node->nodeType != ArrNT || node->dataType == CharDT);
+}
+
+static bool ev_expr(Eval &e, Node *node, long long *value)
+{
+   long long lhs, rhs;
+   if (node == NULL || !ev_step(e))
+      return false;
+   switch (node->nodeType)
+   {
+   case NumConstNT:
+   case BoolConstNT:
+      *value = node->data.Int;
+      return true;
+   case CharConstNT:
+      *value = node->data.Char;
+      return true;
+   case IdNT:
+   case ArrNT:
+   {
+      long long *cell = ev_lvalue(e, node);
+      if (cell == NULL || *cell == EVAL_UNDEF)
+         return false;
+      *value = *cell;
+      return true;
+   }
+   case AssignNT:
+      return ev_assign(e, node, value);
+   case CallNT:
+      return ev_call(e, node, value);
+   case SizeOfNT:
+   {
+      EvalVar *var = node->child[0]->nodeType == IdNT ? ev_lookup(e, node->child[0]->literal) : NULL;
+      if (var == NULL || !var->isArray)
+         return false;
+      *value = var->cells->size();
+      return true;
+   }
+   case SignNT:
+      if (node->tknClass != SUB || !ev_expr(e, node->child[0], &lhs))
+         return false;
+      *value = -lhs;
+      return ev_int(*value);
+   case NotNT:
+      if (!ev_expr(e, node->child[0], &lhs))
+         return false;
+      *value = !lhs;
+      return true;
+   case AndNT:
+   case OrNT:
+      // Both sides are always evaluated by the generated code.
+      if (!ev_expr(e, node->child[0], &lhs) || !ev_expr(e, node->child[1], &rhs))
+         return false;
+      *value = node->nodeType == AndNT ? (lhs && rhs) : (lhs || rhs);
+      return true;
+   case OpNT:
+      if (ev_string_operand(node->child[0]) || ev_string_operand(node->child[1]))
+         return false;
+      if (!ev_expr(e, node->child[0], &lhs) || !ev_expr(e, node->child[1], &rhs))
+         return false;
+      switch (node->tknClass)
+      {
+      case ADD:
+         *value = lhs + rhs;
+         break;
+      case SUB:
+         *value = lhs - rhs;
+         break;
+      case MUL:
+         *value = lhs * rhs;
+         break;
+      case DIV:
+      case MOD:
+         if (rhs == 0)
+            return false;
+         *value = node->tknClass == DIV ? lhs / rhs : tm_mod(lhs, rhs);
+         break;
+      case EQL:
+         *value = lhs == rhs;
+         break;
+      case NEQ:
+         *value = lhs != rhs;
+         break;
+      case LESS:
+         *value = lhs < rhs;
+         break;
+      case LEQ:
+         *value = lhs <= rhs;
+         break;
+      case GREAT:
+         *value = lhs > rhs;
+         break;
+      case GEQ:
+         *value = lhs >= rhs;
+         break;
+      default:
+         return false;
+      }
+      return ev_int(*value);
+   default:
+      // Strings, ?random and anything else unknown.
+      return false;
+   }
+}
+
+static bool ev_decls(Eval &e, Node *node)
+{
+   for (; node != NULL; node = node->sibling)
+   {
+      if (node->isStatic || node->nodeType == StaticNT)
+         return false;
+      if (node->nodeType == VarArrNT)
+      {
+         if (node->child[0] != NULL)
+            return false;
+         ev_declare(e, node->literal, node->size - 1, true);
+      }
+      else if (node->nodeType == VarNT)
+      {
+         long long value = EVAL_UNDEF;
+         if (node->child[0] != NULL && !ev_expr(e, node->child[0], &value))
+            return false;
+         (*ev_declare(e, node->literal, 1, false)->cells)[0] = value;
+      }
+      else
+         return false;
+   }
+   return true;
+}
+
+static EvalStatus ev_stmt(Eval &e, Node *node)
+{
+   long long value;
+   if (!ev_step(e))
+      return EV_FAIL;
+   switch (node->nodeType)
+   {
+   case CompoundNT:
+   {
+      e.scopes.push_back(map<string, EvalVar>());
+      EvalStatus status = ev_decls(e, node->child[0]) ? ev_stmts(e, node->child[1]) : EV_FAIL;
+      e.scopes.pop_back();
+      return status;
+   }
+   case IfNT:
+      if (!ev_expr(e, node->child[0], &value))
+         return EV_FAIL;
+      return ev_stmts(e, value ? node->child[1] : node->child[2]);
+   case IterNT:
+      for (;;)
+      {
+         if (!ev_expr(e, node->child[0], &value))
+            return EV_FAIL;
+         if (!value)
+            return EV_NEXT;
+         EvalStatus status = ev_stmts(e, node->child[1]);
+         if (status == EV_BREAK)
+            return EV_NEXT;
+         if (status != EV_NEXT)
+            return status;
+      }
+   case ToNT:
+   {
+      // Same test as the generated code: index < stop for a positive step,
+      // index > stop otherwise; stop and step are evaluated once.
+      Node *range = node->child[1];
+      long long start, stop, step = 1;
+      if (!ev_expr(e, range->child[0], &start) || !ev_expr(e, range->child[1], &stop) ||
+          (range->child[2] != NULL && !ev_expr(e, range->child[2], &step)))
+         return EV_FAIL;
+      e.scopes.push_back(map<string, EvalVar>());
+      long long *index = &(*ev_declare(e, node->child[0]->literal, 1, false)->cells)[0];
+      EvalStatus status = EV_NEXT;
+      for (*index = start; step > 0 ? *index < stop : *index > stop; *index += step)
+      {
+         status = ev_stmts(e, node->child[2]);
+         if (status == EV_BREAK)
+         {
+            status = EV_NEXT;
+            break;
+         }
+         if (status != EV_NEXT || !ev_step(e) || !ev_int(*index + step))
+         {
+            status = status == EV_NEXT ? EV_FAIL : status;
+            break;
+         }
+      }
+      e.scopes.pop_back();
+      return status;
+   }
+   case ReturnNT:
+      value = 0;
+      if (node->child[0] != NULL && !ev_expr(e, node->child[0], &value))
+         return EV_FAIL;
+      e.retval = value;
+      return EV_RETURN;
+   case BreakNT:
+      return EV_BREAK;
+   default:
+      return ev_expr(e, node, &value) ? EV_NEXT : EV_FAIL;
+   }
+}
+
+static EvalStatus ev_stmts(Eval &e, Node *node)
+{
+   for (; node != NULL; node = node->sibling)
+   {
+      EvalStatus status = ev_stmt(e, node);
+      if (status != EV_NEXT)
+         return status;
+   }
+   return EV_NEXT;
+}
+
+// Runs a call to a user function. Array arguments are passed by reference.
+static bool ev_call(Eval &e, Node *call, long long *value)
+{
+   map<string, Node *>::iterator it = e.funcs.find(call->literal);
+   if (it == e.funcs.end() || it->second->isLib || it->second->isMain || e.depth >= EVAL_DEPTH)
+      return false;
+   Node *func = it->second;
+
+   map<string, EvalVar> parms;
+   Node *arg = call->child[0];
+   for (Node *parm = func->child[0]; parm != NULL; parm = parm->sibling, arg = arg->sibling)
+   {
+      if (arg == NULL)
+         return false;
+      EvalVar var;
+      if (parm->nodeType == ParmArrNT)
+      {
+         EvalVar *array = arg->nodeType == IdNT ? ev_lookup(e, arg->literal) : NULL;
+         if (array == NULL || !array->isArray)
+            return false;
+         var = *array;
+      }
+      else
+      {
+         long long v;
+         if (!ev_expr(e, arg, &v))
+            return false;
+         e.store.push_back(vector<long long>(1, v));
+         var.cells = &e.store.back();
+         var.isArray = false;
+      }
+      parms[parm->literal] = var;
+   }
+
+   size_t frame = e.frame;
+   e.frame = e.scopes.size();
+   e.scopes.push_back(parms);
+   e.depth++;
+   EvalStatus status = ev_stmts(e, func->child[1]);
+   e.depth--;
+   e.scopes.pop_back();
+   e.frame = frame;
+
+   if (status == EV_FAIL || status == EV_BREAK)
+      return false;
+   // Falling off the end leaves garbage in the return register.
+   if (func->dataType != VoidDT && status != EV_RETURN)
+      return false;
+   *value = status == EV_RETURN ? e.retval : 0;
+   return true;
+}
+
+// Replaces pure calls with constant arguments in the expression tree rooted
+// at node (siblings included). Calls that are whole statements are left
+// alone. Returns the node to put in its place.
+static Node *eval_calls(Eval &e, Node *node, bool isStmt, int *total, int *evaluated)
+{
+   if (node == NULL)
+      return NULL;
+   node->sibling = eval_calls(e, node->sibling, isStmt, total, evaluated);
+   bool body[MAXCHILDREN] = {false, false, false};
+   switch (node->nodeType)
+   {
+   case CompoundNT:
+   case IterNT:
+      body[1] = true;
+      break;
+   case IfNT:
+      body[1] = body[2] = true;
+      break;
+   case ToNT:
+      body[2] = true;
+      break;
+   default:
+      break;
+   }
+   for (int i = 0; i < MAXCHILDREN; i++)
+      node->child[i] = eval_calls(e, node->child[i], body[i], total, evaluated);
+
+   if (node->nodeType != CallNT || isStmt)
+      return node;
+   map<string, Node *>::iterator it = e.funcs.find(node->literal);
+   if (it == e.funcs.end() || it->second->isLib || it->second->dataType == VoidDT)
+      return node;
+   int v;
+   for (Node *arg = node->child[0]; arg != NULL; arg = arg->sibling)
+      if (!eval_const(arg, &v))
+         return node;
+   if (*total >= EVAL_TOTAL)
+      return node;
+
+   long long value;
+   e.scopes.clear();
+   e.store.clear();
+   e.scopes.push_back(map<string, EvalVar>());
+   e.frame = 1;
+   e.steps = 0;
+   e.depth = 0;
+   bool ok = ev_call(e, node, &value);
+   *total += e.steps;
+   if (!ok)
+      return node;
+   (*evaluated)++;
+   return make_const(it->second->dataType, (int)value, node);
+}
+
+int evaluate_pure_calls(Node *AST)
+{
+   Eval e;
+   for (Node *itr = AST; itr != NULL; itr = itr->sibling)
+      if (itr->nodeType == FuncNT)
+         e.funcs[itr->literal] = itr;
+
+   int total = 0;
+   int evaluated = 0;
+   for (Node *itr = AST; itr != NULL; itr = itr->sibling)
+      if (itr->nodeType == FuncNT && !itr->isLib)
+         itr->child[1] = eval_calls(e, itr->child[1], true, &total, &evaluated);
+   return evaluated;
+}
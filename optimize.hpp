@@ -0,0 +1,30 @@
+#ifndef _OPTIMIZE_H
+#define _OPTIMIZE_H
+
+#include "AST.hpp"
+#include "parser.tab.h"
+
+/* ==================================================
+   AST OPTIMIZATIONS
+   - Run after semantic analysis, before fix_memory_loops().
+   ================================================== */
+
+// Helpers
+Node *copy_tree(Node *node);
+Node *make_const(DataType type, int value, Node *like);
+bool is_const_node(Node *node);
+bool eval_const(Node *node, int *value);
+Node *fold_expr(Node *node);
+Node *fold_stmts(Node *node);
+int count_tree(Node *node);
+bool writes_var(Node *node, char *name);
+bool declares_var(Node *node, char *name);
+bool is_pure(Node *node);
+bool same_expr(Node *a, Node *b);
+
+// Passes
+int specialize_functions(Node *AST);
+int evaluate_pure_calls(Node *AST);
+int simplify_expressions(Node *AST);
+
+#endif
@@ -0,0 +1,212 @@
+#include "pass_manager.hpp"
+#include "optimize.hpp"
+#include "code_gen.hpp"
+#include "profile.hpp"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+extern int eval_flag;
+extern int spec_flag;
+extern int simplify_flag;
+extern int idiom_flag;
+extern int unroll_flag;
+extern int regloop_flag;
+extern int rotate_flag;
+extern int promote_flag;
+extern int inline_io_flag;
+extern int jumptable_flag;
+extern int dse_flag;
+extern int cfg_flag;
+extern int line_table_flag;
+
+int pass_stats_flag = 0; // Print per-pass changes and timing (-fstats).
+
+struct Pass
+{
+   const char *name;
+   PassKind kind;
+   int *flag;   // The switch the code generator reads.
+   int levels;  // Optimization levels that turn the pass on.
+   int forced;  // -f<name> (1), -fno-<name> (0), neither (-1).
+   int changes; // Rewrites made.
+   double ms;   // Time spent (AST and IR passes).
+};
+
+static Pass passes[PASS_COUNT] = {
+    {"eval", AstPass, &eval_flag, OPT_O2 | OPT_OS, -1, 0, 0},
+    {"specialize", AstPass, &spec_flag, OPT_O2, -1, 0, 0},
+    {"simplify", AstPass, &simplify_flag, OPT_O1 | OPT_O2 | OPT_OS, -1, 0, 0},
+    {"idiom", CodegenPass, &idiom_flag, OPT_O1 | OPT_O2 | OPT_OS, -1, 0, 0},
+    {"unroll", CodegenPass, &unroll_flag, OPT_O2, -1, 0, 0},
+    {"regloop", CodegenPass, &regloop_flag, OPT_O1 | OPT_O2 | OPT_OS, -1, 0, 0},
+    {"rotate", CodegenPass, &rotate_flag, OPT_O2, -1, 0, 0},
+    {"promote", CodegenPass, &promote_flag, OPT_O1 | OPT_O2 | OPT_OS, -1, 0, 0},
+    {"inline-io", CodegenPass, &inline_io_flag, OPT_O1 | OPT_O2 | OPT_OS, -1, 0, 0},
+    {"jumptable", CodegenPass, &jumptable_flag, OPT_O2, -1, 0, 0},
+    {"dse", IrPass, &dse_flag, OPT_O1 | OPT_O2 | OPT_OS, -1, 0, 0},
+    {"cfg", IrPass, &cfg_flag, OPT_O1 | OPT_O2 | OPT_OS, -1, 0, 0},
+};
+
+static int opt_level = OPT_O0;
+
+/* ==================================================
+   OPTIONS
+   ================================================== */
+// "0", "1", "2", "s" or "" (same as 1) from -O<level>.
+bool set_opt_level(const char *level)
+{
+   if (strcmp(level, "0") == 0)
+      opt_level = OPT_O0;
+   else if (strcmp(level, "1") == 0 || level[0] == '\0')
+      opt_level = OPT_O1;
+   else if (strcmp(level, "2") == 0)
+      opt_level = OPT_O2;
+   else if (strcmp(level, "s") == 0)
+      opt_level = OPT_OS;
+   else
+      return false;
+   return true;
+}
+
+// "<pass>", "no-<pass>", "stats", "profile-gen" or "profile-use=<file>" from -f<option>.
+bool set_pass(const char *option)
+{
+   if (strcmp(option, "stats") == 0)
+   {
+      pass_stats_flag = 1;
+      return true;
+   }
+   if (strcmp(option, "line-table") == 0)
+   {
+      line_table_flag = 1;
+      return true;
+   }
+   if (strcmp(option, "coverage") == 0)
+   {
+      set_coverage();
+      return true;
+   }
+   if (strcmp(option, "profile-gen") == 0)
+   {
+      set_profile_gen();
+      return true;
+   }
+   if (strncmp(option, "profile-use=", 12) == 0)
+      return load_profile(option + 12);
+   int enable = 1;
+   if (strncmp(option, "no-", 3) == 0)
+   {
+      enable = 0;
+      option += 3;
+   }
+   for (int i = 0; i < PASS_COUNT; i++)
+   {
+      if (strcmp(passes[i].name, option) == 0)
+      {
+         passes[i].forced = enable;
+         return true;
+      }
+   }
+   return false;
+}
+
+// Turns the passes of the chosen level on. A single-letter flag (-u, -r, ...)
+// already set its pass; -f/-fno- win over both.
+void configure_passes()
+{
+   for (int i = 0; i < PASS_COUNT; i++)
+   {
+      if (passes[i].forced == 0)
+         *passes[i].flag = 0;
+      else if (passes[i].forced == 1 || (passes[i].levels & opt_level))
+         *passes[i].flag = 1;
+   }
+}
+
+bool pass_enabled(PassId id)
+{
+   return *passes[id].flag != 0;
+}
+
+void count_changes(PassId id, int changes)
+{
+   passes[id].changes += changes;
+}
+
+/* ==================================================
+   PIPELINES
+   ================================================== */
+static double elapsed_ms(clock_t start)
+{
+   return (clock() - start) * 1000.0 / CLOCKS_PER_SEC;
+}
+
+void run_ast_passes(Node *AST)
+{
+   for (int i = 0; i < PASS_COUNT; i++)
+   {
+      if (!pass_enabled((PassId)i) || passes[i].kind != AstPass)
+         continue;
+      clock_t start = clock();
+      switch (i)
+      {
+      case PASS_EVAL:
+         passes[i].changes += evaluate_pure_calls(AST);
+         break;
+      case PASS_SPECIALIZE:
+         passes[i].changes += specialize_functions(AST);
+         break;
+      case PASS_SIMPLIFY:
+         passes[i].changes += simplify_expressions(AST);
+         break;
+      }
+      passes[i].ms += elapsed_ms(start);
+   }
+}
+
+bool ir_passes_enabled()
+{
+   for (int i = 0; i < PASS_COUNT; i++)
+      if (pass_enabled((PassId)i) && passes[i].kind == IrPass)
+         return true;
+   return false;
+}
+
+void run_ir_passes(vector<TMLine> &lines)
+{
+   for (int i = 0; i < PASS_COUNT; i++)
+   {
+      if (!pass_enabled((PassId)i) || passes[i].kind != IrPass)
+         continue;
+      clock_t start = clock();
+      switch (i)
+      {
+      case PASS_DSE:
+         passes[i].changes += optimize_stores(lines);
+         break;
+      case PASS_CFG:
+         passes[i].changes += optimize_cfg(lines);
+         break;
+      }
+      passes[i].ms += elapsed_ms(start);
+   }
+}
+
+// Codegen passes run inside generate_code(), so only their changes are known.
+void print_pass_stats()
+{
+   if (!pass_stats_flag)
+      return;
+   fprintf(stderr, "%-12s %-8s %8s %10s\n", "pass", "kind", "changes", "time(ms)");
+   const char *kinds[] = {"ast", "codegen", "ir"};
+   for (int i = 0; i < PASS_COUNT; i++)
+   {
+      if (!pass_enabled((PassId)i))
+         continue;
+      if (passes[i].kind == CodegenPass)
+         fprintf(stderr, "%-12s %-8s %8d %10s\n", passes[i].name, kinds[passes[i].kind], passes[i].changes, "-");
+      else
+         fprintf(stderr, "%-12s %-8s %8d %10.3f\n", passes[i].name, kinds[passes[i].kind], passes[i].changes, passes[i].ms);
+   }
+}
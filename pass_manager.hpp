@@ -0,0 +1,55 @@
+#ifndef _PASS_MANAGER_H
+#define _PASS_MANAGER_H
+
+#include "AST.hpp"
+#include "emitcode.h"
+
+/* ==================================================
+   PASS MANAGER
+   - Optimization passes run in the order of PassId.
+   - AST passes run before fix_memory_loops(), codegen passes switch on
+     alternative code generators, IR passes rewrite the buffered TM code.
+   ================================================== */
+
+typedef enum PID
+{
+   PASS_EVAL,       // AST: evaluate pure calls with constant arguments
+   PASS_SPECIALIZE, // AST: clone functions for constant arguments
+   PASS_SIMPLIFY,   // AST: algebraic identities (codegen: constant operands, MUL by ADD)
+   PASS_IDIOM,      // codegen: array fill/copy loops as SET/MOV
+   PASS_UNROLL,     // codegen: unroll constant-range loops
+   PASS_REGLOOP,    // codegen: for-loop index and bounds in registers
+   PASS_ROTATE,     // codegen: loops tested at the bottom
+   PASS_PROMOTE,    // codegen: hot globals in registers inside loops
+   PASS_INLINE_IO,  // codegen: I/O calls as their IN*/OUT* instruction
+   PASS_JUMPTABLE,  // codegen: if/else-if chains on constants through a jump table
+   PASS_DSE,        // IR: copy propagation and dead store elimination on frame slots
+   PASS_CFG,        // IR: jump threading, empty/unreachable block deletion
+   PASS_COUNT
+} PassId;
+
+typedef enum PK
+{
+   AstPass,
+   CodegenPass,
+   IrPass
+} PassKind;
+
+// Optimization levels (-O0, -O1, -O2, -Os).
+#define OPT_O0 0x1
+#define OPT_O1 0x2
+#define OPT_O2 0x4
+#define OPT_OS 0x8
+
+bool set_opt_level(const char *level);
+bool set_pass(const char *option);
+void configure_passes();
+bool pass_enabled(PassId id);
+void count_changes(PassId id, int changes);
+
+void run_ast_passes(Node *AST);
+bool ir_passes_enabled();
+void run_ir_passes(std::vector<TMLine> &lines);
+void print_pass_stats();
+
+#endif
@@ -0,0 +1,226 @@
+#include "profile.hpp"
+#include "emitcode.h"
+#include <stdio.h>
+#include <string.h>
+#include <map>
+#include <string>
+
+extern Node *current_function;
+
+struct ProfileSite
+{
+   int addr;
+   string kind;
+   string func;
+   int line;
+   string callee;
+};
+
+struct CoverageProbe
+{
+   int addr;
+   string kind;
+   int line;
+   int id;
+};
+
+static bool gen = false;
+static vector<ProfileSite> sites;
+static bool coverage = false;
+static vector<CoverageProbe> probes;
+static map<Node *, int> probe_ids; // one id per statement
+static bool loaded = false;
+static map<string, long long> counts;
+
+// Clones made by the specializer ("f-SP1") count as the function they copy.
+static string source_name(const char *name)
+{
+   string s = name;
+   size_t sp = s.find("-SP");
+   return sp == string::npos ? s : s.substr(0, sp);
+}
+
+static string site_key(const string &kind, const string &func, int line, const string &callee)
+{
+   return kind + " " + func + " " + to_string(line) + " " + callee;
+}
+
+/* ==================================================
+   COLLECTION (-fprofile-gen)
+   ================================================== */
+bool profile_gen_enabled()
+{
+   return gen;
+}
+
+void set_profile_gen()
+{
+   gen = true;
+}
+
+// Records a site at the next instruction address.
+void profile_site(const char *kind, Node *node, const char *callee)
+{
+   if (!gen || node == NULL)
+      return;
+   ProfileSite site;
+   site.addr = emitWhereAmI();
+   site.kind = kind;
+   site.func = current_function != NULL ? source_name(current_function->literal) : "-";
+   site.line = node->lineNum;
+   site.callee = callee != NULL ? source_name(callee) : "-";
+   sites.push_back(site);
+}
+
+// The CFG pass renumbers the instructions it keeps; newLoc maps old to new
+// addresses (a deleted address maps to the next instruction kept).
+static int relocate(vector<int> &newLoc, int addr)
+{
+   if (addr >= (int)newLoc.size())
+      addr = newLoc.size() - 1;
+   return newLoc[addr];
+}
+
+void relocate_profile_sites(vector<int> &newLoc)
+{
+   for (size_t i = 0; i < sites.size(); i++)
+      sites[i].addr = relocate(newLoc, sites[i].addr);
+   for (size_t i = 0; i < probes.size(); i++)
+      probes[i].addr = relocate(newLoc, probes[i].addr);
+}
+
+void emit_profile_sites()
+{
+   if (gen)
+   {
+      emitComment((char *)"PROFILE SITES");
+      for (size_t i = 0; i < sites.size(); i++)
+      {
+         char line[600];
+         snprintf(line, sizeof(line), "SITE %d %s %s %d %s", sites[i].addr, sites[i].kind.c_str(),
+                  sites[i].func.c_str(), sites[i].line, sites[i].callee.c_str());
+         emitComment(line);
+      }
+   }
+   if (coverage)
+   {
+      emitComment((char *)"COVERAGE PROBES");
+      for (size_t i = 0; i < probes.size(); i++)
+      {
+         char line[100];
+         snprintf(line, sizeof(line), "PROBE %d %s %d %d", probes[i].addr, probes[i].kind.c_str(), probes[i].line,
+                  probes[i].id);
+         emitComment(line);
+      }
+   }
+}
+
+/* ==================================================
+   COVERAGE (-fcoverage)
+   ================================================== */
+void set_coverage()
+{
+   coverage = true;
+}
+
+// Records a probe of node at the next instruction address: "stmt" where a
+// statement starts, "then"/"else" where the parts of an IF start, "body"
+// where a loop body starts and "exit" at the jump out of a loop that its
+// failed condition and its BREAKs take. Unrolled copies of a loop body
+// share the id of their node, so their counts add up.
+void coverage_probe(const char *kind, Node *node)
+{
+   if (!coverage || node == NULL)
+      return;
+   map<Node *, int>::iterator it = probe_ids.find(node);
+   int id = probe_ids.size();
+   if (it != probe_ids.end())
+      id = it->second;
+   else
+      probe_ids[node] = id;
+   CoverageProbe probe = {emitWhereAmI(), kind, node->lineNum, id};
+   probes.push_back(probe);
+}
+
+void coverage_statement(Node *node)
+{
+   switch (node->nodeType)
+   {
+   case FuncNT:
+   case AssignNT:
+   case CallNT:
+   case IfNT:
+   case IterNT:
+   case ToNT:
+   case ReturnNT:
+   case BreakNT:
+      coverage_probe("stmt", node);
+      break;
+   default:
+      break;
+   }
+}
+
+/* ==================================================
+   USE (-fprofile-use=<file>)
+   ================================================== */
+bool load_profile(const char *file)
+{
+   FILE *fptr = fopen(file, "r");
+   if (fptr == NULL)
+   {
+      printf("ERROR(ARGLIST): profile \"%s\" could not be opened.\n", file);
+      return false;
+   }
+   char buf[1024];
+   while (fgets(buf, sizeof(buf), fptr) != NULL)
+   {
+      char kind[32], func[256], callee[256];
+      int line;
+      long long count;
+      if (buf[0] == '*' || sscanf(buf, "%31s %255s %d %255s %lld", kind, func, &line, callee, &count) != 5)
+         continue;
+      counts[site_key(kind, func, line, callee)] += count;
+   }
+   fclose(fptr);
+   loaded = true;
+   return true;
+}
+
+bool profile_loaded()
+{
+   return loaded;
+}
+
+long long profile_count(const char *kind, const char *func, int line, const char *callee)
+{
+   if (!loaded)
+      return PROFILE_UNKNOWN;
+   map<string, long long>::iterator it =
+       counts.find(site_key(kind, source_name(func), line, callee != NULL ? source_name(callee) : "-"));
+   return it == counts.end() ? PROFILE_UNKNOWN : it->second;
+}
+
+// Count of a site inside the function being generated.
+long long profile_count(const char *kind, Node *node)
+{
+   if (current_function == NULL)
+      return PROFILE_UNKNOWN;
+   return profile_count(kind, current_function->literal, node->lineNum, NULL);
+}
+
+// Loops the profile saw running (almost) never are not worth unrolling.
+bool profile_cold_loop(Node *loop)
+{
+   long long n = profile_count("loop", loop);
+   return n != PROFILE_UNKNOWN && n < PROFILE_COLD_TRIPS;
+}
+
+// An IF whose THEN part ran more often than its ELSE part is laid out with
+// the THEN part last, so the hot path does not jump around the ELSE.
+bool profile_hot_then(Node *ifNode)
+{
+   long long t = profile_count("then", ifNode);
+   long long e = profile_count("else", ifNode);
+   return t != PROFILE_UNKNOWN && e != PROFILE_UNKNOWN && t > e;
+}
@@ -0,0 +1,44 @@
+#ifndef _PROFILE_H
+#define _PROFILE_H
+
+#include "AST.hpp"
+#include <vector>
+
+using namespace std;
+
+/* ==================================================
+   PROFILE-GUIDED OPTIMIZATION
+   - -fprofile-gen records profile sites (function entries, loop bodies,
+     THEN/ELSE parts, call sites) and writes them after the TM code as
+     "* SITE addr kind function line callee" lines.
+   - ./tm -p <profile> counts the executions of every site and writes one
+     "kind function line callee count" line per C- source location.
+   - -fprofile-use=<profile> reads the counts back for the optimizations.
+   - -fcoverage records coverage probes (statements, THEN/ELSE parts, loop
+     bodies and loop exits) as "* PROBE addr kind line id" lines, id telling
+     the statements apart; ./tm -v <coverage> turns their counts into a
+     per-line report of the C- source. Sites and probes are addresses, no
+     code is added for them.
+   ================================================== */
+
+#define PROFILE_UNKNOWN -1   // Location missing from the profile.
+#define PROFILE_COLD_TRIPS 8 // Loops whose body ran fewer times are cold.
+
+bool profile_gen_enabled();
+void set_profile_gen();
+void profile_site(const char *kind, Node *node, const char *callee);
+void relocate_profile_sites(vector<int> &newLoc);
+void emit_profile_sites();
+
+void set_coverage();
+void coverage_probe(const char *kind, Node *node);
+void coverage_statement(Node *node);
+
+bool load_profile(const char *file);
+bool profile_loaded();
+long long profile_count(const char *kind, const char *func, int line, const char *callee);
+long long profile_count(const char *kind, Node *node);
+bool profile_cold_loop(Node *loop);
+bool profile_hot_then(Node *ifNode);
+
+#endif
@@ -0,0 +1,1597 @@
+#include "tm.hpp"
+#include "tm_jit.hpp"
+#include <ctype.h>
+#include <limits.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <map>
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+static const char *opNames[TM_OP_COUNT] = {
+    "HALT", "NOP", "IN", "INB", "INC", "OUT", "OUTB", "OUTC", "OUTNL",
+    "ADD", "SUB", "MUL", "DIV", "MOD", "AND", "OR", "XOR", "NOT", "NEG",
+    "SWP", "RND", "TLT", "TLE", "TEQ", "TNE", "TGE", "TGT", "SLT", "SGT",
+    "MOV", "SET", "CO", "COA",
+    "LDC", "LDA", "LD", "ST", "JMP", "JNZ", "JZR"};
+
+const char *tm_opcode_name(int op)
+{
+   return op >= 0 && op < TM_OP_COUNT ? opNames[op] : "???";
+}
+
+static int opcode(const char *name)
+{
+   for (int op = 0; op < TM_OP_COUNT; op++)
+      if (strcmp(opNames[op], name) == 0)
+         return op;
+   return -1;
+}
+
+/* ==================================================
+   LOADER
+   ================================================== */
+// Reads the "first last line function" runs of the line table that
+// -fline-table writes next to prog.tm as prog.lines, if there is one. Its
+// functions replace those of the "* FUNCTION" comments.
+static void load_lines(TMProgram &prog, const char *file)
+{
+   string name = file;
+   if (name.size() < 3 || name.compare(name.size() - 3, 3, ".tm") != 0)
+      return;
+   name.replace(name.size() - 3, 3, ".lines");
+   FILE *fptr = fopen(name.c_str(), "r");
+   if (fptr == NULL)
+      return;
+   prog.lines.assign(TM_IMEM_SIZE, 0);
+   char buf[1024], func[256];
+   int first, last, line;
+   while (fgets(buf, sizeof(buf), fptr) != NULL)
+   {
+      if (sscanf(buf, "%d %d %d %255s", &first, &last, &line, func) != 4 || first < 0 || last >= TM_IMEM_SIZE)
+         continue;
+      int f = -1;
+      if (strcmp(func, "-") != 0)
+      {
+         f = find(prog.funcs.begin(), prog.funcs.end(), func) - prog.funcs.begin();
+         if (f == (int)prog.funcs.size())
+            prog.funcs.push_back(func);
+      }
+      for (int a = first; a <= last; a++)
+      {
+         prog.lines[a] = line;
+         prog.funcOf[a] = f;
+      }
+   }
+   fclose(fptr);
+}
+
+// Reads "addr: OP r,s,t" and "addr: OP r,d(s)" lines, "addr: LIT "text""
+// lines, the "* SITE" lines of -fprofile-gen and the "* PROBE" lines of
+// -fcoverage. The "* FUNCTION" and
+// "* END FUNCTION" comments give the function of each instruction, other
+// lines are comments.
+bool tm_load(TMProgram &prog, const char *file)
+{
+   FILE *fptr = fopen(file, "r");
+   if (fptr == NULL)
+   {
+      printf("ERROR: TM file \"%s\" could not be opened.\n", file);
+      return false;
+   }
+   TMInstr halt = {OP_HALT, 0, 0, 0};
+   prog.file = file;
+   prog.iMem.assign(TM_IMEM_SIZE, halt);
+   prog.lits.clear();
+   prog.sites.clear();
+   prog.probes.clear();
+   prog.funcs.clear();
+   prog.funcOf.assign(TM_IMEM_SIZE, -1);
+   prog.lines.clear();
+
+   char buf[1024];
+   int func = -1;
+   int lineNum = 0;
+   bool ok = true;
+   while (fgets(buf, sizeof(buf), fptr) != NULL)
+   {
+      lineNum++;
+      char *p = buf;
+      while (*p == ' ' || *p == '\t')
+         p++;
+      if (strncmp(p, "* SITE ", 7) == 0)
+      {
+         TMSite site;
+         char kind[32], func[256], callee[256];
+         if (sscanf(p + 7, "%d %31s %255s %d %255s", &site.addr, kind, func, &site.line, callee) == 5)
+         {
+            site.kind = kind;
+            site.func = func;
+            site.callee = callee;
+            prog.sites.push_back(site);
+         }
+         continue;
+      }
+      if (strncmp(p, "* PROBE ", 8) == 0)
+      {
+         TMProbe probe;
+         char kind[32];
+         if (sscanf(p + 8, "%d %31s %d %d", &probe.addr, kind, &probe.line, &probe.id) == 4)
+         {
+            probe.kind = kind;
+            prog.probes.push_back(probe);
+         }
+         continue;
+      }
+      char name[256];
+      if (sscanf(p, "* FUNCTION %255s", name) == 1)
+      {
+         func = prog.funcs.size();
+         prog.funcs.push_back(name);
+         continue;
+      }
+      if (strncmp(p, "* END FUNCTION", 14) == 0)
+      {
+         func = -1;
+         continue;
+      }
+      if (!isdigit((unsigned char)*p))
+         continue;
+
+      int addr = atoi(p);
+      char *colon = strchr(p, ':');
+      int len;
+      if (colon == NULL || sscanf(colon + 1, " %15s%n", name, &len) != 1)
+         continue;
+      char *args = colon + 1 + len;
+      if (strcmp(name, "LIT") == 0)
+      {
+         char *q1 = strchr(args, '"');
+         char *q2 = strrchr(args, '"');
+         if (q1 != NULL && q2 > q1)
+            prog.lits.push_back(make_pair(addr, string(q1 + 1, q2 - q1 - 1)));
+         continue;
+      }
+
+      TMInstr in;
+      in.op = opcode(name);
+      int n = 0;
+      if (in.op >= OP_LDC)
+         n = sscanf(args, " %d,%d(%d)", &in.r, &in.s, &in.t);
+      // The compiler writes a few RM instructions in r,s,t form; read them as r,d(s).
+      if (in.op >= OP_LDC && n != 3)
+         n = sscanf(args, " %d,%d,%d", &in.r, &in.s, &in.t);
+      else if (in.op >= 0 && in.op < OP_LDC)
+         n = sscanf(args, " %d,%d,%d", &in.r, &in.s, &in.t);
+      if (in.op < 0 || n != 3 || addr < 0 || addr >= TM_IMEM_SIZE ||
+          in.r < 0 || in.r > 7 || in.t < 0 || in.t > 7 || (in.op < OP_LDC && (in.s < 0 || in.s > 7)))
+      {
+         printf("ERROR: Bad TM instruction at line %d of \"%s\".\n", lineNum, file);
+         ok = false;
+         continue;
+      }
+      prog.iMem[addr] = in;
+      prog.funcOf[addr] = func;
+   }
+   fclose(fptr);
+   load_lines(prog, file);
+   return ok;
+}
+
+/* ==================================================
+   DATA MEMORY
+   ================================================== */
+TMDataMem::TMDataMem() : words(NULL), count(0), bytes(0), mapped(false)
+{
+}
+
+TMDataMem::~TMDataMem()
+{
+   release();
+}
+
+void TMDataMem::release()
+{
+#if defined(__unix__) || defined(__APPLE__)
+   if (mapped)
+      munmap(words, bytes);
+   else
+#endif
+      free(words);
+   words = NULL;
+   count = 0;
+   bytes = 0;
+   mapped = false;
+}
+
+void TMDataMem::assign(long long n)
+{
+   release();
+   count = n;
+   bytes = n * sizeof(long long);
+#if defined(__unix__) || defined(__APPLE__)
+   // MAP_NORESERVE: a large -m only reserves addresses until they are used.
+   void *mem = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+   if (mem != MAP_FAILED)
+   {
+      words = (long long *)mem;
+      mapped = true;
+      return;
+   }
+#endif
+   words = (long long *)calloc(n, sizeof(long long));
+   if (words == NULL)
+   {
+      printf("ERROR: %lld words of data memory could not be allocated.\n", n);
+      exit(1);
+   }
+}
+
+void TMDataMem::clear()
+{
+#if defined(__linux__)
+   // Private anonymous pages read as zero again once they are dropped.
+   if (mapped && madvise(words, bytes, MADV_DONTNEED) == 0)
+      return;
+#endif
+   memset(words, 0, bytes);
+}
+
+// Pages that were never touched are not resident; without mincore every
+// page may be in use.
+vector<bool> TMDataMem::touched()
+{
+   long long pages = (count + TM_PAGE_WORDS - 1) / TM_PAGE_WORDS;
+   vector<bool> used(pages, true);
+#if defined(__linux__)
+   long sysPage = sysconf(_SC_PAGESIZE);
+   if (!mapped || sysPage <= 0)
+      return used;
+   vector<unsigned char> resident((bytes + sysPage - 1) / sysPage);
+   if (mincore(words, bytes, &resident[0]) != 0)
+      return used;
+   for (long long p = 0; p < pages; p++)
+   {
+      size_t first = p * TM_PAGE_WORDS * sizeof(long long) / sysPage;
+      size_t last = (min((p + 1) * TM_PAGE_WORDS, count) * sizeof(long long) - 1) / sysPage;
+      used[p] = false;
+      for (size_t k = first; k <= last && !used[p]; k++)
+         used[p] = resident[k] & 1;
+   }
+#endif
+   return used;
+}
+
+/* ==================================================
+   MACHINE STATE
+   ================================================== */
+void tm_init(TMMachine &m, TMProgram *prog, long long dmemSize)
+{
+   m.prog = prog;
+   m.dMem.assign(dmemSize);
+   m.status = TM_RUNNING;
+   m.steps = 0;
+   m.totalSteps = 0;
+   m.limit = TM_NO_LIMIT;
+   m.echo = false;
+   m.inputPos = 0;
+   m.charLine.clear();
+   m.out = stdout;
+   m.outBuf.clear();
+   m.outBufSize = TM_OUT_BUFFER;
+   m.outMem = NULL;
+   m.outMemSize = 0;
+   m.outMemLen = 0;
+   m.lineStart = true;
+   m.hits.clear();
+   m.jit = NULL;
+   m.calls = NULL;
+   m.checkpoint = NULL;
+   m.checkpointSteps = TM_CHECKPOINT_STEPS;
+   m.resumed = false;
+   m.budget = TM_NO_LIMIT;
+   tm_reset(m);
+}
+
+// The numbers of RND: the additive feedback generator of the glibc rand()
+// (x[i] = x[i-3] + x[i-31]), seeded like srand(1), so programs draw the
+// numbers they drew with rand() while every machine keeps its own state.
+static void rnd_seed(TMMachine &m, unsigned int seed)
+{
+   long long word = seed == 0 ? 1 : seed;
+   m.rnd[0] = word;
+   for (int i = 1; i < 31; i++)
+   {
+      word = (16807 * word) % 2147483647;
+      m.rnd[i] = word;
+   }
+   m.rndFront = 3;
+   m.rndRear = 0;
+   for (int i = 0; i < 310; i++)
+   {
+      m.rnd[m.rndFront] += m.rnd[m.rndRear];
+      m.rndFront = (m.rndFront + 1) % 31;
+      m.rndRear = (m.rndRear + 1) % 31;
+   }
+}
+
+static long long rnd_next(TMMachine &m)
+{
+   unsigned int value = m.rnd[m.rndFront] += m.rnd[m.rndRear];
+   m.rndFront = (m.rndFront + 1) % 31;
+   m.rndRear = (m.rndRear + 1) % 31;
+   return value >> 1;
+}
+
+static void call_unwind(TMMachine &m);
+
+// Clears registers and data memory and places the string literals, as a
+// fresh load of the program does. Profile counts are kept across runs.
+void tm_reset(TMMachine &m)
+{
+   if (m.calls != NULL)
+   {
+      call_unwind(m);
+      m.calls->mark = 0;
+   }
+   long long top = m.dMem.size() - 1;
+   m.dMem.clear();
+   for (int r = 0; r < 8; r++)
+      m.reg[r] = 0;
+   m.reg[0] = top;
+   m.reg[1] = top;
+   m.dMem[0] = top;
+   for (size_t i = 0; i < m.prog->lits.size(); i++)
+   {
+      long long a = top - m.prog->lits[i].first;
+      string &text = m.prog->lits[i].second;
+      if (a + 1 > top || a - (long long)text.size() < 0)
+         continue;
+      m.dMem[a + 1] = text.size();
+      for (size_t k = 0; k < text.size(); k++)
+         m.dMem[a - k] = (unsigned char)text[k];
+   }
+   m.status = TM_RUNNING;
+   m.steps = 0;
+   m.charLine.clear();
+   m.rndCalls = 0;
+   rnd_seed(m, 1);
+}
+
+/* ==================================================
+   OUTPUT
+   ================================================== */
+// Sends the output to buf (size bytes, kept NUL-terminated) instead of the
+// output file. Output that does not fit is dropped.
+void tm_output_to(TMMachine &m, char *buf, size_t size)
+{
+   m.outMem = size > 0 ? buf : NULL;
+   m.outMemSize = size;
+   m.outMemLen = 0;
+   if (m.outMem != NULL)
+      m.outMem[0] = '\0';
+}
+
+// Writes the buffered output to the output file.
+void tm_flush(TMMachine &m)
+{
+   if (m.outMem != NULL || m.out == NULL)
+      return;
+   if (!m.outBuf.empty())
+      fwrite(m.outBuf.data(), 1, m.outBuf.size(), m.out);
+   m.outBuf.clear();
+   fflush(m.out);
+}
+
+static void put_text(TMMachine &m, const char *text, size_t n)
+{
+   if (n == 0)
+      return;
+   m.lineStart = text[n - 1] == '\n';
+   if (m.outMem != NULL)
+   {
+      size_t room = m.outMemSize - 1 - m.outMemLen;
+      if (n > room)
+         n = room;
+      memcpy(m.outMem + m.outMemLen, text, n);
+      m.outMemLen += n;
+      m.outMem[m.outMemLen] = '\0';
+      return;
+   }
+   m.outBuf.append(text, n);
+   if (m.outBuf.size() >= m.outBufSize)
+      tm_flush(m);
+}
+
+static void put(TMMachine &m, const char *fmt, ...)
+{
+   char buf[512];
+   va_list args;
+   va_start(args, fmt);
+   int n = vsnprintf(buf, sizeof(buf), fmt, args);
+   va_end(args);
+   if (n <= 0)
+      return;
+   if (n >= (int)sizeof(buf))
+      n = sizeof(buf) - 1;
+   put_text(m, buf, n);
+}
+
+// OUT: the value and a blank, without going through printf.
+static void put_int(TMMachine &m, long long value)
+{
+   char buf[24];
+   char *p = buf + sizeof(buf);
+   unsigned long long u = value < 0 ? 0ULL - (unsigned long long)value : value;
+   *--p = ' ';
+   do
+   {
+      *--p = '0' + u % 10;
+      u /= 10;
+   } while (u != 0);
+   if (value < 0)
+      *--p = '-';
+   put_text(m, p, buf + sizeof(buf) - p);
+}
+
+// TM messages start on a line of their own.
+static void new_line(TMMachine &m)
+{
+   if (!m.lineStart)
+      put(m, "\n");
+}
+
+/* ==================================================
+   INPUT
+   ================================================== */
+// Next line of the session text (without the newline); false at the end.
+static bool read_line(TMMachine &m, string &line)
+{
+   if (m.inputPos >= m.input.size())
+      return false;
+   size_t end = m.input.find('\n', m.inputPos);
+   if (end == string::npos)
+      end = m.input.size();
+   line = m.input.substr(m.inputPos, end - m.inputPos);
+   m.inputPos = end < m.input.size() ? end + 1 : end;
+   return true;
+}
+
+static bool input_int(TMMachine &m, long long *value)
+{
+   string line;
+   if (!read_line(m, line))
+      return false;
+   *value = atoll(line.c_str());
+   if (m.echo)
+   {
+      new_line(m);
+      put(m, "entered: %lld\n", *value);
+   }
+   return true;
+}
+
+static bool input_bool(TMMachine &m, long long *value)
+{
+   string line;
+   if (!read_line(m, line))
+      return false;
+   size_t p = line.find_first_not_of(" \t");
+   char c = p == string::npos ? '\0' : line[p];
+   if (c == 'T' || c == 't')
+      *value = 1;
+   else if (c == 'F' || c == 'f')
+      *value = 0;
+   else
+      *value = atoll(line.c_str()) != 0;
+   if (m.echo)
+   {
+      new_line(m);
+      put(m, "entered: %c\n", *value ? 'T' : 'F');
+   }
+   return true;
+}
+
+// Characters come from the current line, newline included.
+static bool input_char(TMMachine &m, long long *value)
+{
+   if (m.charLine.empty())
+   {
+      string line;
+      if (!read_line(m, line))
+         return false;
+      m.charLine = line + "\n";
+   }
+   *value = (unsigned char)m.charLine[0];
+   m.charLine.erase(0, 1);
+   return true;
+}
+
+/* ==================================================
+   CALL GRAPH
+   ================================================== */
+static int func_at(TMProgram &prog, long long addr)
+{
+   if (addr < 0 || addr >= TM_IMEM_SIZE || prog.funcOf[addr] < 0)
+      return prog.funcs.size();
+   return prog.funcOf[addr];
+}
+
+// Charges the instructions since the last call or return to the innermost call.
+static void call_charge(TMCallGraph &g, long long steps)
+{
+   g.nodes[g.stack.back().node].self += steps - g.mark;
+   g.mark = steps;
+}
+
+static void call_enter(TMMachine &m, long long target)
+{
+   TMCallGraph &g = *m.calls;
+   call_charge(g, m.steps);
+   int func = func_at(*m.prog, target);
+   int parent = g.stack.back().node;
+   map<int, int>::iterator it = g.nodes[parent].callees.find(func);
+   int node;
+   if (it != g.nodes[parent].callees.end())
+      node = it->second;
+   else
+   {
+      node = g.nodes.size();
+      TMCallNode n;
+      n.func = func;
+      n.parent = parent;
+      n.calls = n.self = 0;
+      g.nodes.push_back(n);
+      g.nodes[parent].callees[func] = node;
+   }
+   g.nodes[node].calls++;
+   g.calls[func]++;
+   g.open[func]++;
+   TMFrame frame = {node, m.steps};
+   g.stack.push_back(frame);
+}
+
+static void call_leave(TMMachine &m)
+{
+   TMCallGraph &g = *m.calls;
+   if (g.stack.size() < 2)
+      return;
+   call_charge(g, m.steps);
+   TMFrame frame = g.stack.back();
+   g.stack.pop_back();
+   int func = g.nodes[frame.node].func;
+   // A recursive function counts once, from its outermost open call.
+   if (--g.open[func] == 0)
+      g.inclusive[func] += m.steps - frame.start;
+}
+
+// Closes the calls still open when the run stopped.
+static void call_unwind(TMMachine &m)
+{
+   while (m.calls->stack.size() > 1)
+      call_leave(m);
+   call_charge(*m.calls, m.steps);
+}
+
+// A JMP is a call when the instruction before it is the LDA 3,1(7) that
+// saves its return address, and a return when it jumps to 0(3).
+static void call_jump(TMMachine &m, long long pc, TMInstr &in)
+{
+   if (in.t == 7 && pc > 0 && m.reg[3] == pc + 1)
+   {
+      TMInstr &save = m.prog->iMem[pc - 1];
+      if (save.op == OP_LDA && save.r == 3 && save.s == 1 && save.t == 7)
+         call_enter(m, m.reg[7]);
+   }
+   else if (in.t == 3 && in.s == 0)
+      call_leave(m);
+}
+
+TMCallGraph *tm_call_graph_new(TMProgram &prog)
+{
+   TMCallGraph *g = new TMCallGraph;
+   int outside = prog.funcs.size();
+   TMCallNode root;
+   root.func = outside;
+   root.parent = -1;
+   root.calls = root.self = 0;
+   g->nodes.push_back(root);
+   TMFrame frame = {0, 0};
+   g->stack.push_back(frame);
+   g->open.assign(outside + 1, 0);
+   g->calls.assign(outside + 1, 0);
+   g->inclusive.assign(outside + 1, 0);
+   g->mark = 0;
+   return g;
+}
+
+void tm_call_graph_free(TMCallGraph *calls)
+{
+   delete calls;
+}
+
+/* ==================================================
+   EXECUTION
+   ================================================== */
+// MOD of the reference TM: a negative remainder gets |t| added, so
+// -10 % 3 is 2 and -331 % -31 is 10. x % -1 is 0 (C traps on LLONG_MIN).
+static long long mod(long long s, long long t)
+{
+   long long r = t == -1 ? 0 : s % t;
+   if (r < 0)
+      r += t < 0 ? -t : t;
+   return r;
+}
+
+// Interprets instructions until the machine stops or has executed pause
+// instructions (then it is still running, unless that is the abort limit).
+static void execute(TMMachine &m, long long pause)
+{
+   vector<TMInstr> &iMem = m.prog->iMem;
+   long long *dMem = m.dMem.data();
+   long long *reg = m.reg;
+   long long dSize = m.dMem.size();
+   bool profiling = !m.hits.empty();
+   bool tracing = m.calls != NULL;
+
+   while (m.status == TM_RUNNING)
+   {
+      long long pc = reg[7];
+      if (pc < 0 || pc >= TM_IMEM_SIZE)
+      {
+         m.status = TM_IMEM_ERROR;
+         break;
+      }
+      if (m.steps >= pause)
+      {
+         if (m.limit != TM_NO_LIMIT && m.steps >= m.limit)
+            m.status = TM_LIMIT;
+         break;
+      }
+      TMInstr &in = iMem[pc];
+      reg[7] = pc + 1;
+      m.steps++;
+      if (profiling)
+         m.hits[pc]++;
+
+      long long &r = reg[in.r];
+      long long a;
+      switch (in.op)
+      {
+      case OP_HALT:
+         m.status = TM_HALTED;
+         break;
+      case OP_NOP:
+         break;
+      case OP_IN:
+         tm_flush(m);
+         if (!input_int(m, &r))
+            m.status = TM_NO_INPUT;
+         break;
+      case OP_INB:
+         tm_flush(m);
+         if (!input_bool(m, &r))
+            m.status = TM_NO_INPUT;
+         break;
+      case OP_INC:
+         tm_flush(m);
+         if (!input_char(m, &r))
+            m.status = TM_NO_INPUT;
+         break;
+      case OP_OUT:
+         put_int(m, r);
+         break;
+      case OP_OUTB:
+         put_text(m, r ? "T " : "F ", 2);
+         break;
+      case OP_OUTC:
+      {
+         char c = (char)r;
+         put_text(m, &c, 1);
+         break;
+      }
+      case OP_OUTNL:
+         put_text(m, "\n", 1);
+         break;
+      case OP_ADD:
+         r = reg[in.s] + reg[in.t];
+         break;
+      case OP_SUB:
+         r = reg[in.s] - reg[in.t];
+         break;
+      case OP_MUL:
+         r = reg[in.s] * reg[in.t];
+         break;
+      case OP_DIV:
+      case OP_MOD:
+         if (reg[in.t] == 0)
+            m.status = TM_ZERO_DIV;
+         else
+            r = in.op == OP_DIV ? reg[in.s] / reg[in.t] : mod(reg[in.s], reg[in.t]);
+         break;
+      case OP_AND:
+         r = reg[in.s] & reg[in.t];
+         break;
+      case OP_OR:
+         r = reg[in.s] | reg[in.t];
+         break;
+      case OP_XOR:
+         r = reg[in.s] ^ reg[in.t];
+         break;
+      case OP_NOT:
+         r = !reg[in.s];
+         break;
+      case OP_NEG:
+         r = -reg[in.s];
+         break;
+      case OP_SWP: // r <- min(r,s), s <- max(r,s)
+         if (r > reg[in.s])
+         {
+            long long tmp = r;
+            r = reg[in.s];
+            reg[in.s] = tmp;
+         }
+         break;
+      case OP_RND:
+         if (reg[in.s] > 0)
+         {
+            r = rnd_next(m) % reg[in.s];
+            m.rndCalls++;
+         }
+         else
+            r = 0;
+         break;
+      case OP_TLT:
+         r = reg[in.s] < reg[in.t];
+         break;
+      case OP_TLE:
+         r = reg[in.s] <= reg[in.t];
+         break;
+      case OP_TEQ:
+         r = reg[in.s] == reg[in.t];
+         break;
+      case OP_TNE:
+         r = reg[in.s] != reg[in.t];
+         break;
+      case OP_TGE:
+         r = reg[in.s] >= reg[in.t];
+         break;
+      case OP_TGT:
+         r = reg[in.s] > reg[in.t];
+         break;
+      case OP_SLT: // r > 0 ? s < t : s > t
+         r = r > 0 ? reg[in.s] < reg[in.t] : reg[in.s] > reg[in.t];
+         break;
+      case OP_SGT:
+         r = reg[in.s] > reg[in.t];
+         break;
+      case OP_MOV: // dMem[r-k] <- dMem[s-k], k < t
+      case OP_SET: // dMem[r-k] <- s, k < t
+      case OP_CO:  // compare dMem[r-k] to dMem[s-k], k < t
+      case OP_COA:
+      {
+         long long to = r, from = reg[in.s], n = reg[in.t];
+         if (n > 0 && (to - n + 1 < 0 || to >= dSize ||
+                       (in.op != OP_SET && (from - n + 1 < 0 || from >= dSize))))
+         {
+            m.status = TM_DMEM_ERROR;
+            break;
+         }
+         if (in.op == OP_MOV)
+            for (long long k = 0; k < n; k++)
+               dMem[to - k] = dMem[from - k];
+         else if (in.op == OP_SET)
+            for (long long k = 0; k < n; k++)
+               dMem[to - k] = from;
+         else
+         {
+            long long k = 0;
+            while (k < n && dMem[to - k] == dMem[from - k])
+               k++;
+            r = k < n ? dMem[to - k] : 0;
+            reg[in.s] = k < n ? dMem[from - k] : 0;
+         }
+         break;
+      }
+      case OP_LDC:
+         r = in.s;
+         break;
+      case OP_LDA:
+         r = in.s + reg[in.t];
+         break;
+      case OP_LD:
+      case OP_ST:
+         a = in.s + reg[in.t];
+         if (a < 0 || a >= dSize)
+            m.status = TM_DMEM_ERROR;
+         else if (in.op == OP_LD)
+            r = dMem[a];
+         else
+            dMem[a] = r;
+         break;
+      case OP_JMP:
+         reg[7] = in.s + reg[in.t];
+         if (tracing)
+            call_jump(m, pc, in);
+         break;
+      case OP_JNZ:
+         if (r != 0)
+            reg[7] = in.s + reg[in.t];
+         break;
+      case OP_JZR:
+         if (r == 0)
+            reg[7] = in.s + reg[in.t];
+         break;
+      }
+   }
+}
+
+// Runs the instruction at the PC, or stops the machine at the abort limit.
+void tm_step(TMMachine &m)
+{
+   long long pause = m.steps + 1;
+   if (m.limit != TM_NO_LIMIT && m.limit < pause)
+      pause = m.limit;
+   execute(m, pause);
+}
+
+static void run(TMMachine &m)
+{
+   if (m.jit != NULL && m.hits.empty() && m.calls == NULL)
+      tm_jit_run(m.jit, m);
+   else
+      execute(m, m.limit != TM_NO_LIMIT ? m.limit : LLONG_MAX);
+}
+
+// Runs until the machine stops, compiled when a JIT was attached to it.
+// With a checkpoint file the run stops every checkpointSteps instructions
+// (as at an abort limit) to write it. A budget lowers the abort limit to
+// what the session has left (totalSteps holds the steps before this run).
+TMStatus tm_run(TMMachine &m)
+{
+   m.status = TM_RUNNING;
+   long long abortLimit = m.limit;
+   if (m.budget != TM_NO_LIMIT)
+   {
+      long long left = m.budget - m.totalSteps;
+      if (left <= m.steps)
+      {
+         m.status = TM_LIMIT;
+         return m.status;
+      }
+      if (m.limit == TM_NO_LIMIT || m.limit > left)
+         m.limit = left;
+   }
+   if (m.checkpoint == NULL)
+      run(m);
+   long long limit = m.limit;
+   while (m.checkpoint != NULL)
+   {
+      long long pause = m.steps + m.checkpointSteps;
+      m.limit = limit != TM_NO_LIMIT && limit <= pause ? limit : pause;
+      run(m);
+      m.limit = limit;
+      if (m.status != TM_LIMIT || (limit != TM_NO_LIMIT && m.steps >= limit))
+         break;
+      m.status = TM_RUNNING;
+      tm_flush(m);
+      if (!tm_write_checkpoint(m, m.checkpoint))
+         fprintf(stderr, "WARNING: checkpoint \"%s\" could not be written.\n", m.checkpoint);
+   }
+   m.limit = abortLimit;
+   tm_flush(m);
+   return m.status;
+}
+
+const char *tm_status_text(TMStatus status)
+{
+   switch (status)
+   {
+   case TM_RUNNING:
+      return "Running";
+   case TM_HALTED:
+      return "Halted";
+   case TM_LIMIT:
+      return "Abort limit reached";
+   case TM_NO_INPUT:
+      return "Out of input";
+   case TM_ZERO_DIV:
+      return "Division by zero";
+   case TM_IMEM_ERROR:
+      return "Instruction memory access out of range";
+   case TM_DMEM_ERROR:
+      return "Data memory access out of range";
+   }
+   return "";
+}
+
+/* ==================================================
+   SESSION
+   ================================================== */
+// Command letters: u (echo input values), a N (abort limit), o N (accepted,
+// no effect), g (go), l (reload), q or x (quit). Input read by IN/INB/INC
+// comes from the lines after the g that started the run.
+// Runs the program; totalSteps holds the instructions of the session
+// before this run.
+static void go(TMMachine &m)
+{
+   tm_run(m);
+   m.totalSteps += m.steps;
+   if (m.status != TM_HALTED)
+   {
+      new_line(m);
+      put(m, "ERROR: %s after %lld instructions.\n", tm_status_text(m.status), m.steps);
+   }
+}
+
+void tm_session(TMMachine &m)
+{
+   // A resumed session finishes the run it was checkpointed in first.
+   if (m.resumed)
+   {
+      m.resumed = false;
+      go(m);
+   }
+   else
+      put(m, "Loading file: %s\n", m.prog->file.c_str());
+   string line;
+   while (read_line(m, line))
+   {
+      size_t p = line.find_first_not_of(" \t\r");
+      if (p == string::npos)
+         continue;
+      char cmd = line[p];
+      switch (cmd)
+      {
+      case 'u':
+         m.echo = true;
+         break;
+      case 'a':
+         m.limit = atoll(line.c_str() + p + 1);
+         break;
+      case 'o':
+         break;
+      case 'g':
+         if (m.status != TM_RUNNING)
+            tm_reset(m);
+         m.totalSteps -= m.steps;
+         go(m);
+         break;
+      case 'l':
+         tm_reset(m);
+         new_line(m);
+         put(m, "Loading file: %s\n", m.prog->file.c_str());
+         break;
+      case 'q':
+      case 'x':
+         new_line(m);
+         put(m, "Bye.\n");
+         tm_flush(m);
+         return;
+      default:
+         new_line(m);
+         put(m, "ERROR: TM Command %c unknown.\n", cmd);
+         break;
+      }
+   }
+   new_line(m);
+   put(m, "Bye.\n");
+   tm_flush(m);
+}
+
+/* ==================================================
+   PROFILE
+   ================================================== */
+// Sums the executions of the site addresses per C- source location, one
+// "kind function line callee count" line per location in program order.
+bool tm_write_profile(TMMachine &m, const char *file)
+{
+   FILE *fptr = fopen(file, "w");
+   if (fptr == NULL)
+      return false;
+   vector<string> order;
+   map<string, long long> counts;
+   vector<TMSite> &sites = m.prog->sites;
+   for (size_t i = 0; i < sites.size(); i++)
+   {
+      char key[600];
+      snprintf(key, sizeof(key), "%s %s %d %s", sites[i].kind.c_str(), sites[i].func.c_str(), sites[i].line,
+               sites[i].callee.c_str());
+      if (counts.find(key) == counts.end())
+      {
+         order.push_back(key);
+         counts[key] = 0;
+      }
+      if (sites[i].addr >= 0 && sites[i].addr < (int)m.hits.size())
+         counts[key] += m.hits[sites[i].addr];
+   }
+   fprintf(fptr, "* C- profile of %s\n", m.prog->file.c_str());
+   fprintf(fptr, "* kind function line callee count\n");
+   for (size_t i = 0; i < order.size(); i++)
+      fprintf(fptr, "%s %lld\n", order[i].c_str(), counts[order[i]]);
+   fclose(fptr);
+   return true;
+}
+/* ==================================================
+   EXECUTION REPORT
+   ================================================== */
+// One line of the report: executions summed per opcode, function, C- line
+// or address. Fields that do not apply to the section are -1.
+struct TMReportRow
+{
+   int addr;
+   int op;
+   int func; // index in funcs, funcs.size() for instructions outside functions
+   int line;
+   long long count;
+};
+
+struct TMReportSection
+{
+   const char *name;
+   vector<TMReportRow> rows;
+};
+
+// Highest count first, equal counts in program order.
+static bool count_greater(const TMReportRow &a, const TMReportRow &b)
+{
+   return a.count > b.count;
+}
+
+static void add_row(TMReportSection &section, int addr, int op, int func, int line, long long count)
+{
+   TMReportRow row = {addr, op, func, line, count};
+   section.rows.push_back(row);
+}
+
+// C- source line of every address: the line of the closest -fprofile-gen
+// site at or before it in the same function, 0 when there is none.
+static vector<int> site_lines(TMProgram &prog)
+{
+   vector<int> lines(TM_IMEM_SIZE, 0);
+   vector<pair<int, int> > sites;
+   for (size_t i = 0; i < prog.sites.size(); i++)
+      if (prog.sites[i].addr >= 0 && prog.sites[i].addr < TM_IMEM_SIZE)
+         sites.push_back(make_pair(prog.sites[i].addr, prog.sites[i].line));
+   stable_sort(sites.begin(), sites.end());
+   size_t next = 0;
+   int line = 0, func = -1;
+   for (int a = 0; a < TM_IMEM_SIZE; a++)
+   {
+      if (prog.funcOf[a] != func)
+      {
+         func = prog.funcOf[a];
+         line = 0;
+      }
+      while (next < sites.size() && sites[next].first <= a)
+         line = sites[next++].second;
+      lines[a] = line;
+   }
+   return lines;
+}
+
+static const char *func_name(TMProgram &prog, int func)
+{
+   return func < (int)prog.funcs.size() ? prog.funcs[func].c_str() : "-";
+}
+
+static double percent(long long count, long long total)
+{
+   return total > 0 ? 100.0 * count / total : 0.0;
+}
+
+static void write_text(FILE *fptr, TMProgram &prog, TMReportSection &section, long long total)
+{
+   TMReportRow &first = section.rows[0];
+   fprintf(fptr, "*\n*%s%s%s%s count percent\n", first.addr >= 0 ? " address" : "", first.op >= 0 ? " opcode" : "",
+           first.func >= 0 ? " function" : "", first.line >= 0 ? " line" : "");
+   for (size_t i = 0; i < section.rows.size(); i++)
+   {
+      TMReportRow &row = section.rows[i];
+      if (row.addr >= 0)
+         fprintf(fptr, "%d ", row.addr);
+      if (row.op >= 0)
+         fprintf(fptr, "%s ", tm_opcode_name(row.op));
+      if (row.func >= 0)
+         fprintf(fptr, "%s ", func_name(prog, row.func));
+      if (row.line >= 0)
+         fprintf(fptr, "%d ", row.line);
+      fprintf(fptr, "%lld %.2f\n", row.count, percent(row.count, total));
+   }
+}
+
+static void write_json_string(FILE *fptr, const char *text)
+{
+   fputc('"', fptr);
+   for (; *text != '\0'; text++)
+   {
+      if (*text == '"' || *text == '\\')
+         fputc('\\', fptr);
+      if ((unsigned char)*text >= ' ')
+         fputc(*text, fptr);
+   }
+   fputc('"', fptr);
+}
+
+static void write_json(FILE *fptr, TMProgram &prog, TMReportSection &section, long long total)
+{
+   fprintf(fptr, ",\n  \"%s\": [", section.name);
+   for (size_t i = 0; i < section.rows.size(); i++)
+   {
+      TMReportRow &row = section.rows[i];
+      fprintf(fptr, "%s\n    {", i > 0 ? "," : "");
+      if (row.addr >= 0)
+         fprintf(fptr, "\"address\": %d, ", row.addr);
+      if (row.op >= 0)
+         fprintf(fptr, "\"opcode\": \"%s\", ", tm_opcode_name(row.op));
+      if (row.func >= 0)
+      {
+         fprintf(fptr, "\"function\": ");
+         write_json_string(fptr, func_name(prog, row.func));
+         fprintf(fptr, ", ");
+      }
+      if (row.line >= 0)
+         fprintf(fptr, "\"line\": %d, ", row.line);
+      fprintf(fptr, "\"count\": %lld, \"percent\": %.2f}", row.count, percent(row.count, total));
+   }
+   fprintf(fptr, "\n  ]");
+}
+
+// Writes the executions counted per address, summed per opcode, function
+// and C- line and sorted by count, as text to file and as JSON to
+// file.json. Lines come from the line table, or from the sites of a
+// program compiled with -fprofile-gen.
+bool tm_write_report(TMMachine &m, const char *file)
+{
+   TMProgram &prog = *m.prog;
+   vector<int> lines = prog.lines.empty() ? site_lines(prog) : prog.lines;
+   int outside = prog.funcs.size();
+   long long total = 0;
+   vector<long long> ops(TM_OP_COUNT, 0);
+   vector<long long> funcs(outside + 1, 0);
+   map<pair<int, int>, long long> funcLines;
+   TMReportSection sections[4] = {{"opcodes"}, {"functions"}, {"lines"}, {"addresses"}};
+   for (int a = 0; a < (int)m.hits.size(); a++)
+   {
+      long long n = m.hits[a];
+      if (n == 0)
+         continue;
+      int func = prog.funcOf[a] >= 0 ? prog.funcOf[a] : outside;
+      total += n;
+      ops[prog.iMem[a].op] += n;
+      funcs[func] += n;
+      funcLines[make_pair(func, lines[a])] += n;
+      add_row(sections[3], a, prog.iMem[a].op, func, lines[a], n);
+   }
+   for (int op = 0; op < TM_OP_COUNT; op++)
+      if (ops[op] > 0)
+         add_row(sections[0], -1, op, -1, -1, ops[op]);
+   for (int f = 0; f <= outside; f++)
+      if (funcs[f] > 0)
+         add_row(sections[1], -1, -1, f, -1, funcs[f]);
+   for (map<pair<int, int>, long long>::iterator it = funcLines.begin(); it != funcLines.end(); ++it)
+      add_row(sections[2], -1, -1, it->first.first, it->first.second, it->second);
+   for (int s = 0; s < 4; s++)
+      stable_sort(sections[s].rows.begin(), sections[s].rows.end(), count_greater);
+
+   FILE *fptr = fopen(file, "w");
+   if (fptr == NULL)
+      return false;
+   fprintf(fptr, "* TM execution report of %s\n", prog.file.c_str());
+   fprintf(fptr, "* %lld instructions executed\n", total);
+   for (int s = 0; s < 4 && total > 0; s++)
+      write_text(fptr, prog, sections[s], total);
+   fclose(fptr);
+
+   string json = string(file) + ".json";
+   fptr = fopen(json.c_str(), "w");
+   if (fptr == NULL)
+      return false;
+   fprintf(fptr, "{\n  \"file\": ");
+   write_json_string(fptr, prog.file.c_str());
+   fprintf(fptr, ",\n  \"instructions\": %lld", total);
+   for (int s = 0; s < 4; s++)
+      write_json(fptr, prog, sections[s], total);
+   fprintf(fptr, "\n}\n");
+   fclose(fptr);
+   return true;
+}
+
+// The calls from the start of the run to node, outermost first.
+static string call_path(TMProgram &prog, TMCallGraph &g, int node)
+{
+   if (node == 0)
+      return "-";
+   string path = func_name(prog, g.nodes[node].func);
+   for (int n = g.nodes[node].parent; n != 0; n = g.nodes[n].parent)
+      path = string(func_name(prog, g.nodes[n].func)) + ";" + path;
+   return path;
+}
+
+struct TMCallRow
+{
+   int func;
+   long long inclusive;
+};
+
+static bool inclusive_greater(const TMCallRow &a, const TMCallRow &b)
+{
+   return a.inclusive > b.inclusive;
+}
+
+// Writes the calls, inclusive and exclusive instruction counts of every
+// function and the calls between functions to file, and the instructions
+// of every chain of calls as folded stacks ("main;fib;fib count", the
+// input of flame graph tools) to file.folded.
+bool tm_write_call_graph(TMMachine &m, const char *file)
+{
+   TMProgram &prog = *m.prog;
+   TMCallGraph &g = *m.calls;
+   call_unwind(m);
+   int outside = prog.funcs.size();
+   long long total = 0;
+   vector<long long> exclusive(outside + 1, 0);
+   map<pair<int, int>, long long> edges;
+   for (size_t n = 0; n < g.nodes.size(); n++)
+   {
+      total += g.nodes[n].self;
+      exclusive[g.nodes[n].func] += g.nodes[n].self;
+      if (n > 0)
+         edges[make_pair(g.nodes[g.nodes[n].parent].func, g.nodes[n].func)] += g.nodes[n].calls;
+   }
+   g.inclusive[outside] = total;
+   vector<TMCallRow> rows;
+   for (int f = 0; f <= outside; f++)
+      if (g.calls[f] > 0 || exclusive[f] > 0)
+      {
+         TMCallRow row = {f, g.inclusive[f]};
+         rows.push_back(row);
+      }
+   stable_sort(rows.begin(), rows.end(), inclusive_greater);
+
+   FILE *fptr = fopen(file, "w");
+   if (fptr == NULL)
+      return false;
+   fprintf(fptr, "* TM call graph of %s\n", prog.file.c_str());
+   fprintf(fptr, "* %lld instructions executed\n", total);
+   fprintf(fptr, "*\n* function calls inclusive percent exclusive percent\n");
+   for (size_t i = 0; i < rows.size(); i++)
+   {
+      int f = rows[i].func;
+      fprintf(fptr, "%s %lld %lld %.2f %lld %.2f\n", func_name(prog, f), g.calls[f], g.inclusive[f],
+              percent(g.inclusive[f], total), exclusive[f], percent(exclusive[f], total));
+   }
+   fprintf(fptr, "*\n* caller callee calls\n");
+   for (map<pair<int, int>, long long>::iterator it = edges.begin(); it != edges.end(); ++it)
+      fprintf(fptr, "%s %s %lld\n", func_name(prog, it->first.first), func_name(prog, it->first.second), it->second);
+   fclose(fptr);
+
+   string folded = string(file) + ".folded";
+   fptr = fopen(folded.c_str(), "w");
+   if (fptr == NULL)
+      return false;
+   for (size_t n = 0; n < g.nodes.size(); n++)
+      if (g.nodes[n].self > 0)
+         fprintf(fptr, "%s %lld\n", call_path(prog, g, n).c_str(), g.nodes[n].self);
+   fclose(fptr);
+   return true;
+}
+
+/* ==================================================
+   COVERAGE
+   ================================================== */
+// Counts of the probes of one statement.
+struct TMStatement
+{
+   int line;
+   long long stmt, then, other, body, exit; // other: the ELSE part
+   bool hasStmt, hasThen, hasElse, hasBody, hasExit;
+};
+
+// Writes the C- source of the program (prog.c- next to prog.tm) with the
+// executions of every line, the largest count of a statement starting on
+// it, and the branches taken by its IF and loop statements below it.
+// "#####" marks lines with statements that never ran.
+bool tm_write_coverage(TMMachine &m, const char *file)
+{
+   TMProgram &prog = *m.prog;
+   map<int, TMStatement> stmts;
+   for (size_t i = 0; i < prog.probes.size(); i++)
+   {
+      TMProbe &probe = prog.probes[i];
+      long long n = probe.addr >= 0 && probe.addr < (int)m.hits.size() ? m.hits[probe.addr] : 0;
+      if (stmts.find(probe.id) == stmts.end())
+      {
+         TMStatement st = {probe.line, 0, 0, 0, 0, 0, false, false, false, false, false};
+         stmts[probe.id] = st;
+      }
+      TMStatement &st = stmts[probe.id];
+      if (probe.kind == "stmt")
+      {
+         st.stmt += n;
+         st.hasStmt = true;
+      }
+      else if (probe.kind == "then")
+      {
+         st.then += n;
+         st.hasThen = true;
+      }
+      else if (probe.kind == "else")
+      {
+         st.other += n;
+         st.hasElse = true;
+      }
+      else if (probe.kind == "body")
+      {
+         st.body += n;
+         st.hasBody = true;
+      }
+      else if (probe.kind == "exit")
+      {
+         st.exit += n;
+         st.hasExit = true;
+      }
+   }
+
+   map<int, long long> lines; // line -> executions
+   map<int, vector<string> > branches;
+   int stmtCount = 0, stmtRun = 0, branchCount = 0, branchTaken = 0;
+   for (map<int, TMStatement>::iterator it = stmts.begin(); it != stmts.end(); ++it)
+   {
+      TMStatement &st = it->second;
+      if (st.hasStmt)
+      {
+         stmtCount++;
+         stmtRun += st.stmt > 0;
+         if (lines.find(st.line) == lines.end() || lines[st.line] < st.stmt)
+            lines[st.line] = st.stmt;
+      }
+      char text[100];
+      if (st.hasThen)
+      {
+         // Without an ELSE part, the IF that did not run its THEN part fell through.
+         long long other = st.hasElse ? st.other : st.stmt - st.then;
+         snprintf(text, sizeof(text), "branch then %lld, else %lld", st.then, other);
+         branchCount += 2;
+         branchTaken += (st.then > 0) + (other > 0);
+      }
+      else if (st.hasBody && st.hasExit)
+      {
+         snprintf(text, sizeof(text), "branch body %lld, exit %lld", st.body, st.exit);
+         branchCount += 2;
+         branchTaken += (st.body > 0) + (st.exit > 0);
+      }
+      else if (st.hasBody) // unrolled and rotated loops have no exit probe
+      {
+         snprintf(text, sizeof(text), "branch body %lld", st.body);
+         branchCount++;
+         branchTaken += st.body > 0;
+      }
+      else
+         continue;
+      branches[st.line].push_back(text);
+   }
+
+   FILE *fptr = fopen(file, "w");
+   if (fptr == NULL)
+      return false;
+   fprintf(fptr, "* C- coverage of %s\n", prog.file.c_str());
+   fprintf(fptr, "* statements run: %d of %d (%.2f%%)\n", stmtRun, stmtCount, percent(stmtRun, stmtCount));
+   fprintf(fptr, "* branches taken: %d of %d (%.2f%%)\n", branchTaken, branchCount, percent(branchTaken, branchCount));
+
+   string source = prog.file;
+   if (source.size() >= 3 && source.compare(source.size() - 3, 3, ".tm") == 0)
+      source.replace(source.size() - 3, 3, ".c-");
+   FILE *src = fopen(source.c_str(), "r");
+   char buf[1024];
+   int last = lines.empty() ? 0 : lines.rbegin()->first;
+   for (int line = 1; src != NULL ? fgets(buf, sizeof(buf), src) != NULL : line <= last; line++)
+   {
+      if (src == NULL)
+      {
+         if (lines.find(line) == lines.end())
+            continue;
+         buf[0] = '\0';
+      }
+      buf[strcspn(buf, "\r\n")] = '\0';
+      if (lines.find(line) == lines.end())
+         fprintf(fptr, "%9s:%5d:%s\n", "-", line, buf);
+      else if (lines[line] == 0)
+         fprintf(fptr, "%9s:%5d:%s\n", "#####", line, buf);
+      else
+         fprintf(fptr, "%9lld:%5d:%s\n", lines[line], line, buf);
+      for (size_t b = 0; b < branches[line].size(); b++)
+         fprintf(fptr, "%15s %s\n", "", branches[line][b].c_str());
+   }
+   if (src != NULL)
+      fclose(src);
+   fclose(fptr);
+   return true;
+}
+
+/* ==================================================
+   CHECKPOINT
+   ================================================== */
+// A checkpoint holds the registers and counters of a running session, its
+// place in the input, the file offset of the output written so far and the
+// data memory pages with nonzero words, in the byte order of the host.
+static const char checkpointMagic[8] = {'T', 'M', 'C', 'K', 'P', 'T', '1', '\n'};
+
+// FNV-1a hash of n bytes, chained from h.
+static unsigned long long hash_bytes(unsigned long long h, const void *data, size_t n)
+{
+   const unsigned char *p = (const unsigned char *)data;
+   for (size_t i = 0; i < n; i++)
+      h = (h ^ p[i]) * 1099511628211ULL;
+   return h;
+}
+
+static long long program_hash(TMProgram &prog)
+{
+   unsigned long long h = 14695981039346656037ULL;
+   h = hash_bytes(h, &prog.iMem[0], prog.iMem.size() * sizeof(TMInstr));
+   for (size_t i = 0; i < prog.lits.size(); i++)
+   {
+      h = hash_bytes(h, &prog.lits[i].first, sizeof(int));
+      h = hash_bytes(h, prog.lits[i].second.data(), prog.lits[i].second.size());
+   }
+   return h;
+}
+
+static long long input_hash(TMMachine &m)
+{
+   return hash_bytes(14695981039346656037ULL, m.input.data(), m.input.size());
+}
+
+// The header words, in file order.
+enum
+{
+   CK_PROGRAM, CK_DSIZE, CK_INPUT_SIZE, CK_INPUT_HASH, CK_INPUT_POS, CK_REG,
+   CK_STEPS = CK_REG + 8, CK_TOTAL_STEPS, CK_LIMIT, CK_ECHO, CK_LINE_START,
+   CK_RND_CALLS, CK_OUT_POS, CK_CHAR_LINE, CK_PAGES, CK_WORDS
+};
+
+// Written next to file and renamed over it, so a run stopped while it is
+// written leaves the previous checkpoint.
+bool tm_write_checkpoint(TMMachine &m, const char *file)
+{
+   vector<bool> touched = m.dMem.touched();
+   vector<long long> pages;
+   long long *words = m.dMem.data();
+   long long size = m.dMem.size();
+   for (long long p = 0; p < (long long)touched.size(); p++)
+   {
+      if (!touched[p])
+         continue;
+      long long end = min((p + 1) * TM_PAGE_WORDS, size);
+      long long a = p * TM_PAGE_WORDS;
+      while (a < end && words[a] == 0)
+         a++;
+      if (a < end)
+         pages.push_back(p);
+   }
+
+   long long head[CK_WORDS];
+   head[CK_PROGRAM] = program_hash(*m.prog);
+   head[CK_DSIZE] = size;
+   head[CK_INPUT_SIZE] = m.input.size();
+   head[CK_INPUT_HASH] = input_hash(m);
+   head[CK_INPUT_POS] = m.inputPos;
+   for (int r = 0; r < 8; r++)
+      head[CK_REG + r] = m.reg[r];
+   head[CK_STEPS] = m.steps;
+   head[CK_TOTAL_STEPS] = m.totalSteps;
+   head[CK_LIMIT] = m.limit;
+   head[CK_ECHO] = m.echo;
+   head[CK_LINE_START] = m.lineStart;
+   head[CK_RND_CALLS] = m.rndCalls;
+   head[CK_OUT_POS] = -1;
+#if defined(__unix__) || defined(__APPLE__)
+   if (m.out != NULL && m.outMem == NULL)
+      head[CK_OUT_POS] = ftello(m.out);
+#endif
+   head[CK_CHAR_LINE] = m.charLine.size();
+   head[CK_PAGES] = pages.size();
+
+   string temp = string(file) + ".tmp";
+   FILE *fptr = fopen(temp.c_str(), "wb");
+   if (fptr == NULL)
+      return false;
+   bool ok = fwrite(checkpointMagic, 1, sizeof(checkpointMagic), fptr) == sizeof(checkpointMagic) &&
+             fwrite(head, sizeof(long long), CK_WORDS, fptr) == CK_WORDS &&
+             fwrite(m.charLine.data(), 1, m.charLine.size(), fptr) == m.charLine.size();
+   for (size_t i = 0; ok && i < pages.size(); i++)
+   {
+      long long first = pages[i] * TM_PAGE_WORDS;
+      size_t n = min((long long)TM_PAGE_WORDS, size - first);
+      ok = fwrite(&pages[i], sizeof(long long), 1, fptr) == 1 && fwrite(words + first, sizeof(long long), n, fptr) == n;
+   }
+   ok = fclose(fptr) == 0 && ok;
+   if (ok && rename(temp.c_str(), file) == 0)
+      return true;
+   remove(temp.c_str());
+   return false;
+}
+
+// Restores a checkpoint of the same program and input (and data memory
+// size) and marks the session as resumed. Output written after the
+// checkpoint is cut off the output file when it can be.
+bool tm_read_checkpoint(TMMachine &m, const char *file)
+{
+   FILE *fptr = fopen(file, "rb");
+   if (fptr == NULL)
+   {
+      printf("ERROR: checkpoint \"%s\" could not be opened.\n", file);
+      return false;
+   }
+   char magic[sizeof(checkpointMagic)];
+   long long head[CK_WORDS];
+   if (fread(magic, 1, sizeof(magic), fptr) != sizeof(magic) || memcmp(magic, checkpointMagic, sizeof(magic)) != 0 ||
+       fread(head, sizeof(long long), CK_WORDS, fptr) != CK_WORDS)
+   {
+      printf("ERROR: \"%s\" is not a TM checkpoint.\n", file);
+      fclose(fptr);
+      return false;
+   }
+   const char *mismatch = NULL;
+   if (head[CK_PROGRAM] != program_hash(*m.prog))
+      mismatch = "program";
+   else if (head[CK_DSIZE] != m.dMem.size())
+      mismatch = "data memory size";
+   else if (head[CK_INPUT_SIZE] != (long long)m.input.size() || head[CK_INPUT_HASH] != input_hash(m))
+      mismatch = "input";
+   if (mismatch != NULL)
+   {
+      printf("ERROR: checkpoint \"%s\" was written with another %s.\n", file, mismatch);
+      fclose(fptr);
+      return false;
+   }
+
+   tm_reset(m);
+   long long size = m.dMem.size();
+   m.charLine.assign(head[CK_CHAR_LINE], '\0');
+   bool ok = fread(&m.charLine[0], 1, m.charLine.size(), fptr) == m.charLine.size();
+   for (long long i = 0; ok && i < head[CK_PAGES]; i++)
+   {
+      long long page;
+      ok = fread(&page, sizeof(long long), 1, fptr) == 1 && page >= 0 && page * TM_PAGE_WORDS < size;
+      if (!ok)
+         break;
+      long long first = page * TM_PAGE_WORDS;
+      size_t n = min((long long)TM_PAGE_WORDS, size - first);
+      ok = fread(m.dMem.data() + first, sizeof(long long), n, fptr) == n;
+   }
+   fclose(fptr);
+   if (!ok)
+   {
+      printf("ERROR: checkpoint \"%s\" is truncated.\n", file);
+      return false;
+   }
+   m.inputPos = head[CK_INPUT_POS];
+   for (int r = 0; r < 8; r++)
+      m.reg[r] = head[CK_REG + r];
+   m.steps = head[CK_STEPS];
+   m.totalSteps = head[CK_TOTAL_STEPS];
+   m.limit = head[CK_LIMIT];
+   m.echo = head[CK_ECHO];
+   m.lineStart = head[CK_LINE_START];
+   m.rndCalls = head[CK_RND_CALLS];
+   for (long long i = 0; i < m.rndCalls; i++)
+      rnd_next(m);
+#if defined(__unix__) || defined(__APPLE__)
+   long long outPos = head[CK_OUT_POS];
+   if (outPos >= 0 && m.out != NULL && m.outMem == NULL && fseeko(m.out, 0, SEEK_END) == 0 && ftello(m.out) >= outPos)
+   {
+      fflush(m.out);
+      if (ftruncate(fileno(m.out), outPos) == 0)
+         fseeko(m.out, outPos, SEEK_SET);
+   }
+#endif
+   m.status = TM_RUNNING;
+   m.resumed = true;
+   return true;
+}
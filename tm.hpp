@@ -0,0 +1,195 @@
+#ifndef _TM_H
+#define _TM_H
+
+#include <stdio.h>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/* ==================================================
+   TM VIRTUAL MACHINE
+   - Loads the .tm files written by the compiler and runs them with the
+     semantics of the course TM (registers 0-7, r7 is the PC, GP starts at
+     the top of data memory, string literals are placed below GP).
+   - A session reads TM commands (u, a, g, l, q, x, ...) and the program's
+     input lines from the same text, like the TM reads its stdin.
+   - Output is collected in a buffer and written when an IN* instruction
+     runs, when the run stops or when the buffer is full. It can also go to
+     a memory buffer of the caller instead of a file.
+   ================================================== */
+
+#define TM_IMEM_SIZE 20000  // Instruction memory (unloaded addresses hold HALT).
+#define TM_DMEM_SIZE 10000  // Default data memory.
+#define TM_NO_LIMIT 0       // Abort limit meaning "run until HALT".
+#define TM_OUT_BUFFER 65536 // Output bytes held before they are written.
+#define TM_CHECKPOINT_STEPS 100000000 // Default instructions between checkpoints.
+#define TM_PAGE_WORDS 512   // Words per data memory page of a checkpoint.
+
+typedef enum TMOP
+{
+   // Register only: r,s,t
+   OP_HALT, OP_NOP, OP_IN, OP_INB, OP_INC, OP_OUT, OP_OUTB, OP_OUTC, OP_OUTNL,
+   OP_ADD, OP_SUB, OP_MUL, OP_DIV, OP_MOD, OP_AND, OP_OR, OP_XOR, OP_NOT, OP_NEG,
+   OP_SWP, OP_RND, OP_TLT, OP_TLE, OP_TEQ, OP_TNE, OP_TGE, OP_TGT, OP_SLT, OP_SGT,
+   OP_MOV, OP_SET, OP_CO, OP_COA,
+   // Register to memory: r,d(s)
+   OP_LDC, OP_LDA, OP_LD, OP_ST, OP_JMP, OP_JNZ, OP_JZR,
+   TM_OP_COUNT
+} TMOpcode;
+
+typedef enum TMS
+{
+   TM_RUNNING,
+   TM_HALTED,     // HALT executed
+   TM_LIMIT,      // abort limit reached
+   TM_NO_INPUT,   // IN* with the input exhausted
+   TM_ZERO_DIV,   // DIV or MOD by zero
+   TM_IMEM_ERROR, // PC outside instruction memory
+   TM_DMEM_ERROR  // load or store outside data memory
+} TMStatus;
+
+struct TMInstr
+{
+   int op;
+   int r, s, t; // RM instructions: r, d in s, base register in t
+};
+
+// A profile site recorded by the compiler (-fprofile-gen) as a "* SITE" line.
+struct TMSite
+{
+   int addr;
+   string kind;   // func, loop, then, else or call
+   string func;   // enclosing C- function
+   int line;      // C- source line
+   string callee; // call sites only, "-" otherwise
+};
+
+// A coverage probe recorded by the compiler (-fcoverage) as a "* PROBE" line.
+struct TMProbe
+{
+   int addr;
+   string kind; // stmt, then, else, body or exit
+   int line;    // C- source line
+   int id;      // statement the probe belongs to
+};
+
+struct TMProgram
+{
+   string file;
+   vector<TMInstr> iMem;
+   vector<pair<int, string> > lits; // LIT lines: offset below GP, text
+   vector<TMSite> sites;
+   vector<TMProbe> probes;
+   vector<string> funcs; // functions of the "* FUNCTION" comments, in file order
+   vector<int> funcOf;   // index in funcs of the function holding each address (-1: none)
+   vector<int> lines;    // C- line of each address from the .lines file (empty: none)
+};
+
+// A node of the calling-context tree of the call-graph profile: one node
+// per chain of calls from the start of the run. Node 0 stands for the code
+// outside any call (the init section).
+struct TMCallNode
+{
+   int func;              // index in funcs, funcs.size() outside functions
+   int parent;            // -1 for node 0
+   long long calls;       // times the chain was entered
+   long long self;        // instructions executed with the chain innermost
+   map<int, int> callees; // func -> node
+};
+
+struct TMFrame
+{
+   int node;
+   long long start; // steps when the call was made
+};
+
+struct TMCallGraph
+{
+   vector<TMCallNode> nodes;
+   vector<TMFrame> stack;       // open calls, innermost last (node 0 first)
+   vector<int> open;            // open calls per function
+   vector<long long> calls;     // calls per function
+   vector<long long> inclusive; // instructions executed inside calls, per function
+   long long mark;              // steps at the last call or return
+};
+
+// Data memory: an anonymous mapping the OS commits page by page as the
+// program first touches it, so a run costs only the pages it uses. A reset
+// hands the pages back instead of clearing every word.
+struct TMDataMem
+{
+   TMDataMem();
+   ~TMDataMem();
+   void assign(long long count); // count zeroed words
+   void clear();                 // zero every word
+   vector<bool> touched();       // pages of TM_PAGE_WORDS that may hold nonzero words
+   long long size() const { return count; }
+   long long *data() { return words; }
+   long long &operator[](long long a) { return words[a]; }
+
+private:
+   TMDataMem(const TMDataMem &);
+   TMDataMem &operator=(const TMDataMem &);
+   void release();
+   long long *words;
+   long long count;
+   size_t bytes;  // size of the mapping
+   bool mapped;   // false: heap block (no mmap)
+};
+
+struct TMJit;
+
+struct TMMachine
+{
+   TMProgram *prog;
+   TMDataMem dMem;
+   long long reg[8];
+   TMStatus status;
+   long long steps;        // instructions executed since the last load
+   long long totalSteps;   // instructions executed in the session
+   long long limit;        // abort limit, TM_NO_LIMIT for none
+   bool echo;              // echo input values ("entered: 5"), set by u
+   string input;           // commands and program input
+   size_t inputPos;        // read position in input
+   string charLine;        // rest of the line INC is reading from
+   FILE *out;              // program output
+   string outBuf;          // output not written to out yet
+   size_t outBufSize;      // bytes outBuf holds before it is written (0: none)
+   char *outMem;           // caller buffer taking the output instead of out, or NULL
+   size_t outMemSize;      // size of outMem, the terminating NUL included
+   size_t outMemLen;       // bytes stored in outMem
+   bool lineStart;         // nothing written yet on the current output line
+   vector<long long> hits; // executions per address while profiling (empty: off)
+   TMJit *jit;             // native code of the program (NULL: interpreted)
+   TMCallGraph *calls;     // call-graph profile (NULL: off)
+   unsigned int rnd[31];   // RND generator state, one per machine so machines can run on threads
+   int rndFront, rndRear;  // positions in rnd of the generator's two taps
+   long long rndCalls;     // RND numbers drawn since the last reset, replayed on resume
+   long long budget;       // instructions the whole session may execute (TM_NO_LIMIT: no cap)
+   const char *checkpoint; // file written every checkpointSteps instructions (NULL: none)
+   long long checkpointSteps;
+   bool resumed;           // state read from a checkpoint, the run goes on first
+};
+
+const char *tm_opcode_name(int op);
+bool tm_load(TMProgram &prog, const char *file);
+void tm_init(TMMachine &m, TMProgram *prog, long long dmemSize);
+void tm_reset(TMMachine &m);
+void tm_output_to(TMMachine &m, char *buf, size_t size);
+void tm_flush(TMMachine &m);
+void tm_step(TMMachine &m);
+TMStatus tm_run(TMMachine &m);
+const char *tm_status_text(TMStatus status);
+bool tm_write_checkpoint(TMMachine &m, const char *file);
+bool tm_read_checkpoint(TMMachine &m, const char *file);
+void tm_session(TMMachine &m);
+bool tm_write_profile(TMMachine &m, const char *file);
+bool tm_write_report(TMMachine &m, const char *file);
+TMCallGraph *tm_call_graph_new(TMProgram &prog);
+void tm_call_graph_free(TMCallGraph *calls);
+bool tm_write_call_graph(TMMachine &m, const char *file);
+bool tm_write_coverage(TMMachine &m, const char *file);
+
+#endif
@@ -0,0 +1,368 @@
+#include "tm.hpp"
+#include "tm_jit.hpp"
+#include <dirent.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+/* ==================================================
+   Batch runner for the TM virtual machine!
+   - ./tmbatch [options] <file.tm | directory> ..., runs every program in
+     one process on a pool of threads and compares its output with the
+     .expected file next to it.
+   - The commands and input of a program come from <name>.in, or from the
+     runExamples.in of its directory, as the examples are laid out. A
+     program with neither is just run: "g" then "q".
+   - Each thread has a queue of programs. A thread takes its own from the
+     back and, once its queue is empty, steals from the front of the other
+     queues, so a few long programs do not leave the other threads idle.
+   - Every program has a machine of its own (data memory, output buffer,
+     RND state) and a budget of instructions for its whole session.
+   ================================================== */
+
+#define BATCH_STEPS 1000000000LL // Default instructions per program.
+#define BATCH_OUTPUT (1 << 20)   // Output bytes kept per program.
+#define BATCH_INPUT "g\nq\n"   // Commands of a program without an input file.
+
+enum BatchResult
+{
+   BATCH_PASS,
+   BATCH_FAIL,        // output differs from .expected
+   BATCH_BUDGET,      // the session used up its instructions
+   BATCH_NO_EXPECTED, // ran, nothing to compare with
+   BATCH_ERROR        // not loaded or no input
+};
+
+static const char *resultNames[] = {"PASS", "FAIL", "BUDGET", "RAN", "ERROR"};
+
+struct BatchJob
+{
+   string tmFile;
+   string inFile; // empty: BATCH_INPUT
+   string expectedFile;
+   BatchResult result;
+   long long steps;
+   double ms;
+   string detail; // first difference or error
+};
+
+struct BatchQueue
+{
+   mutex lock;
+   deque<int> jobs;
+};
+
+struct BatchOptions
+{
+   long long dmemSize;
+   long long budget;
+   bool jit;
+};
+
+static void usage()
+{
+   printf("Usage: ./tmbatch [-t<threads>] [-a<steps>] [-m<size>] [-j] [-q] <file.tm | directory> ...\n");
+   printf("   -t<threads>  threads running programs (default: one per core)\n");
+   printf("   -a<steps>    instructions each program may execute, 0 for no limit (default %lld)\n", BATCH_STEPS);
+   printf("   -m<size>     data memory size (default %d)\n", TM_DMEM_SIZE);
+   printf("   -j           translate the programs to native code before running them\n");
+   printf("   -q           list only the programs that did not pass\n");
+   exit(1);
+}
+
+static bool read_file(const string &file, string &text)
+{
+   FILE *fptr = fopen(file.c_str(), "rb");
+   if (fptr == NULL)
+      return false;
+   char buf[4096];
+   size_t n;
+   text.clear();
+   while ((n = fread(buf, 1, sizeof(buf), fptr)) > 0)
+      text.append(buf, n);
+   fclose(fptr);
+   return true;
+}
+
+static bool exists(const string &file)
+{
+   struct stat st;
+   return stat(file.c_str(), &st) == 0 && S_ISREG(st.st_mode);
+}
+
+/* ==================================================
+   PROGRAMS
+   ================================================== */
+// A .tm file, its input and its expected output.
+static void add_job(vector<BatchJob> &jobs, const string &tmFile)
+{
+   BatchJob job;
+   string base = tmFile.substr(0, tmFile.size() - 3);
+   size_t slash = tmFile.rfind('/');
+   string dir = slash == string::npos ? "" : tmFile.substr(0, slash + 1);
+   job.tmFile = tmFile;
+   if (exists(base + ".in"))
+      job.inFile = base + ".in";
+   else if (exists(dir + "runExamples.in"))
+      job.inFile = dir + "runExamples.in";
+   job.expectedFile = base + ".expected";
+   job.result = BATCH_ERROR;
+   job.steps = 0;
+   job.ms = 0;
+   jobs.push_back(job);
+}
+
+static bool is_tm_file(const string &file)
+{
+   return file.size() > 3 && file.compare(file.size() - 3, 3, ".tm") == 0;
+}
+
+// The .tm files of a directory, by name.
+static bool add_directory(vector<BatchJob> &jobs, string dir)
+{
+   DIR *dptr = opendir(dir.c_str());
+   if (dptr == NULL)
+      return false;
+   if (dir[dir.size() - 1] != '/')
+      dir += '/';
+   vector<string> files;
+   struct dirent *entry;
+   while ((entry = readdir(dptr)) != NULL)
+      if (is_tm_file(entry->d_name))
+         files.push_back(dir + entry->d_name);
+   closedir(dptr);
+   sort(files.begin(), files.end());
+   for (size_t i = 0; i < files.size(); i++)
+      add_job(jobs, files[i]);
+   return true;
+}
+
+/* ==================================================
+   COMPARISON
+   ================================================== */
+// The lines of an output with the blanks at either end removed, without
+// blank lines and "Loading file" lines (the .expected files name the .tm
+// file by another path). The .expected files of compiled examples start
+// with the compiler's messages: only what follows the first "Loading
+// file" line is kept of them.
+static vector<string> output_lines(const string &text, bool fromLoad)
+{
+   vector<string> lines;
+   bool keep = !fromLoad;
+   size_t pos = 0;
+   while (pos < text.size())
+   {
+      size_t end = text.find('\n', pos);
+      if (end == string::npos)
+         end = text.size();
+      size_t first = text.find_first_not_of(" \t\r", pos);
+      if (first != string::npos && first < end)
+      {
+         size_t last = text.find_last_not_of(" \t\r", end - 1);
+         string line = text.substr(first, last + 1 - first);
+         if (line.compare(0, 13, "Loading file:") == 0)
+            keep = true;
+         else if (keep)
+            lines.push_back(line);
+      }
+      pos = end + 1;
+   }
+   return lines;
+}
+
+// Empty when the outputs match, otherwise the first line that differs.
+static string difference(const string &output, const string &expected)
+{
+   vector<string> got = output_lines(output, false);
+   vector<string> want = output_lines(expected, true);
+   size_t n = min(got.size(), want.size());
+   size_t i = 0;
+   while (i < n && got[i] == want[i])
+      i++;
+   if (i == got.size() && i == want.size())
+      return "";
+   char buf[64];
+   snprintf(buf, sizeof(buf), "output line %d: ", (int)i + 1);
+   string text = buf;
+   text += i < want.size() ? "expected \"" + want[i] + "\"" : "expected the end";
+   text += i < got.size() ? ", got \"" + got[i] + "\"" : ", got the end";
+   return text;
+}
+
+/* ==================================================
+   RUNNING
+   ================================================== */
+static void run_job(BatchJob &job, const BatchOptions &opt, vector<char> &out)
+{
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   string input = BATCH_INPUT;
+   string expected;
+   TMProgram prog;
+   if (!job.inFile.empty() && !read_file(job.inFile, input))
+      job.detail = "no input file \"" + job.inFile + "\"";
+   else if (!tm_load(prog, job.tmFile.c_str()))
+      job.detail = "the program could not be loaded";
+   else
+   {
+      TMMachine m;
+      tm_init(m, &prog, opt.dmemSize);
+      tm_output_to(m, &out[0], out.size());
+      m.out = NULL;
+      m.budget = opt.budget;
+      m.input = input;
+      if (opt.jit)
+         m.jit = tm_jit_compile(prog);
+      tm_session(m);
+      tm_jit_free(m.jit);
+      job.steps = m.totalSteps;
+      if (m.status == TM_LIMIT && opt.budget != TM_NO_LIMIT && m.totalSteps >= opt.budget)
+      {
+         job.result = BATCH_BUDGET;
+         job.detail = "stopped after the budget of instructions";
+      }
+      else if (!read_file(job.expectedFile, expected))
+         job.result = BATCH_NO_EXPECTED;
+      else if (m.outMemLen + 1 >= out.size())
+      {
+         job.result = BATCH_FAIL;
+         job.detail = "more output than the runner keeps";
+      }
+      else
+      {
+         job.detail = difference(string(&out[0], m.outMemLen), expected);
+         job.result = job.detail.empty() ? BATCH_PASS : BATCH_FAIL;
+      }
+   }
+   job.ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+// The next program for thread self: its own newest, or the oldest of
+// another thread. -1 when every queue is empty (no program adds others).
+static int next_job(vector<BatchQueue> &queues, int self)
+{
+   for (size_t k = 0; k < queues.size(); k++)
+   {
+      BatchQueue &q = queues[(self + k) % queues.size()];
+      lock_guard<mutex> hold(q.lock);
+      if (q.jobs.empty())
+         continue;
+      int job;
+      if (k == 0)
+      {
+         job = q.jobs.back();
+         q.jobs.pop_back();
+      }
+      else
+      {
+         job = q.jobs.front();
+         q.jobs.pop_front();
+      }
+      return job;
+   }
+   return -1;
+}
+
+static void worker(int self, vector<BatchQueue> *queues, vector<BatchJob> *jobs, const BatchOptions *opt)
+{
+   vector<char> out(BATCH_OUTPUT);
+   int job;
+   while ((job = next_job(*queues, self)) >= 0)
+      run_job((*jobs)[job], *opt, out);
+}
+
+int main(int argc, char *argv[])
+{
+   BatchOptions opt;
+   opt.dmemSize = TM_DMEM_SIZE;
+   opt.budget = BATCH_STEPS;
+   opt.jit = false;
+   int threads = thread::hardware_concurrency();
+   bool quiet = false;
+   vector<BatchJob> jobs;
+
+   int i = 1;
+   for (; i < argc && argv[i][0] == '-'; i++)
+   {
+      switch (argv[i][1])
+      {
+      case 't':
+         threads = atoi(&argv[i][2]);
+         if (threads < 1)
+            usage();
+         break;
+      case 'a':
+         opt.budget = atoll(&argv[i][2]);
+         if (opt.budget < 0)
+            usage();
+         break;
+      case 'm':
+         opt.dmemSize = atoll(&argv[i][2]);
+         if (opt.dmemSize < 2)
+            usage();
+         break;
+      case 'j':
+         opt.jit = true;
+         break;
+      case 'q':
+         quiet = true;
+         break;
+      default:
+         usage();
+      }
+   }
+   if (i >= argc)
+      usage();
+   for (; i < argc; i++)
+   {
+      if (is_tm_file(argv[i]))
+         add_job(jobs, argv[i]);
+      else if (!add_directory(jobs, argv[i]))
+      {
+         printf("ERROR: \"%s\" is neither a .tm file nor a directory.\n", argv[i]);
+         exit(1);
+      }
+   }
+   if (threads < 1)
+      threads = 1;
+   if (threads > (int)jobs.size())
+      threads = jobs.empty() ? 1 : jobs.size();
+
+   // Programs are dealt to the queues in turn.
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   vector<BatchQueue> queues(threads);
+   for (size_t j = 0; j < jobs.size(); j++)
+      queues[j % threads].jobs.push_back(j);
+   vector<thread> pool;
+   for (int t = 1; t < threads; t++)
+      pool.push_back(thread(worker, t, &queues, &jobs, &opt));
+   worker(0, &queues, &jobs, &opt);
+   for (size_t t = 0; t < pool.size(); t++)
+      pool[t].join();
+   double wall = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+   int counts[BATCH_ERROR + 1] = {0};
+   long long steps = 0;
+   double busy = 0;
+   for (size_t j = 0; j < jobs.size(); j++)
+   {
+      BatchJob &job = jobs[j];
+      counts[job.result]++;
+      steps += job.steps;
+      busy += job.ms;
+      if (quiet && (job.result == BATCH_PASS || job.result == BATCH_NO_EXPECTED))
+         continue;
+      printf("%-6s %10.2f ms %12lld  %s", resultNames[job.result], job.ms, job.steps, job.tmFile.c_str());
+      if (!job.detail.empty())
+         printf(": %s", job.detail.c_str());
+      printf("\n");
+   }
+   printf("%d programs: %d passed, %d failed, %d over budget, %d without .expected, %d errors\n", (int)jobs.size(),
+          counts[BATCH_PASS], counts[BATCH_FAIL], counts[BATCH_BUDGET], counts[BATCH_NO_EXPECTED], counts[BATCH_ERROR]);
+   printf("%lld instructions, %.2f ms of program time in %.2f ms on %d threads\n", steps, busy, wall, threads);
+   return counts[BATCH_FAIL] + counts[BATCH_BUDGET] + counts[BATCH_ERROR] > 0 ? 1 : 0;
+}
@@ -0,0 +1,499 @@
+#include "tm_c.hpp"
+#include <string.h>
+
+/* ==================================================
+   RUNTIME
+   ================================================== */
+// Everything but the program: the machine state and the I/O and session
+// code of tm.cpp, in C.
+static const char *runtime[] = {
+    "#include <limits.h>",
+    "#include <stdarg.h>",
+    "#include <stdio.h>",
+    "#include <stdlib.h>",
+    "#include <string.h>",
+    "",
+    "#ifdef TM_FAST",
+    "#define STEP(a)",
+    "#else",
+    "#define STEP(a)          \\",
+    "   if (count >= pause)   \\",
+    "   {                     \\",
+    "      pc = a;            \\",
+    "      goto stop;         \\",
+    "   }                     \\",
+    "   count++;",
+    "#endif",
+    "#define FAULT(a, s) \\",
+    "   {                \\",
+    "      pc = (a) + 1; \\",
+    "      status = s;   \\",
+    "      goto stop;    \\",
+    "   }",
+    "#define CHECK(a) \\",
+    "   if ((unsigned long long)addr >= (unsigned long long)dSize) FAULT(a, TM_DMEM_ERROR)",
+    "",
+    "enum",
+    "{",
+    "   TM_RUNNING, TM_HALTED, TM_LIMIT, TM_NO_INPUT, TM_ZERO_DIV, TM_IMEM_ERROR, TM_DMEM_ERROR",
+    "};",
+    "static const char *statusText[] = {\"Running\", \"Halted\", \"Abort limit reached\", \"Out of input\",",
+    "                                   \"Division by zero\", \"Instruction memory access out of range\",",
+    "                                   \"Data memory access out of range\"};",
+    "",
+    "static long long *dMem, dSize = TM_DMEM_SIZE, reg[8], steps, totalSteps, limit;",
+    "static int status, echo;",
+    "static char *input, *charLine;",
+    "static size_t inputLen, inputPos, charLen, charPos;",
+    "static char outBuf[65536];",
+    "static size_t outLen;",
+    "static int lineStart = 1;",
+    "",
+    "static void flush_out(void)",
+    "{",
+    "   fwrite(outBuf, 1, outLen, stdout);",
+    "   outLen = 0;",
+    "   fflush(stdout);",
+    "}",
+    "",
+    "static void put_text(const char *text, size_t n)",
+    "{",
+    "   if (n == 0)",
+    "      return;",
+    "   lineStart = text[n - 1] == '\\n';",
+    "   if (outLen + n > sizeof(outBuf))",
+    "      flush_out();",
+    "   if (n > sizeof(outBuf))",
+    "      n = sizeof(outBuf);",
+    "   memcpy(outBuf + outLen, text, n);",
+    "   outLen += n;",
+    "}",
+    "",
+    "static void put(const char *fmt, ...)",
+    "{",
+    "   char buf[512];",
+    "   va_list args;",
+    "   int n;",
+    "   va_start(args, fmt);",
+    "   n = vsnprintf(buf, sizeof(buf), fmt, args);",
+    "   va_end(args);",
+    "   if (n <= 0)",
+    "      return;",
+    "   if (n >= (int)sizeof(buf))",
+    "      n = sizeof(buf) - 1;",
+    "   put_text(buf, n);",
+    "}",
+    "",
+    "static void new_line(void)",
+    "{",
+    "   if (!lineStart)",
+    "      put(\"\\n\");",
+    "}",
+    "",
+    "/* Next line of stdin (without the newline), NUL-terminated; NULL at the end. */",
+    "static char *read_line(void)",
+    "{",
+    "   size_t end = inputPos;",
+    "   char *line;",
+    "   if (inputPos >= inputLen)",
+    "      return NULL;",
+    "   while (end < inputLen && input[end] != '\\n')",
+    "      end++;",
+    "   line = input + inputPos;",
+    "   input[end] = '\\0';",
+    "   inputPos = end < inputLen ? end + 1 : end;",
+    "   return line;",
+    "}",
+    "",
+    "static int input_int(long long *value)",
+    "{",
+    "   char *line = read_line();",
+    "   if (line == NULL)",
+    "      return 0;",
+    "   *value = atoll(line);",
+    "   if (echo)",
+    "   {",
+    "      new_line();",
+    "      put(\"entered: %lld\\n\", *value);",
+    "   }",
+    "   return 1;",
+    "}",
+    "",
+    "static int input_bool(long long *value)",
+    "{",
+    "   char *line = read_line(), *p;",
+    "   if (line == NULL)",
+    "      return 0;",
+    "   p = line + strspn(line, \" \\t\");",
+    "   if (*p == 'T' || *p == 't')",
+    "      *value = 1;",
+    "   else if (*p == 'F' || *p == 'f')",
+    "      *value = 0;",
+    "   else",
+    "      *value = atoll(line) != 0;",
+    "   if (echo)",
+    "   {",
+    "      new_line();",
+    "      put(\"entered: %c\\n\", *value ? 'T' : 'F');",
+    "   }",
+    "   return 1;",
+    "}",
+    "",
+    "/* Characters come from the current line, newline included. */",
+    "static int input_char(long long *value)",
+    "{",
+    "   if (charPos >= charLen)",
+    "   {",
+    "      char *line = read_line();",
+    "      if (line == NULL)",
+    "         return 0;",
+    "      charLen = strlen(line) + 1;",
+    "      charLine = (char *)realloc(charLine, charLen);",
+    "      memcpy(charLine, line, charLen - 1);",
+    "      charLine[charLen - 1] = '\\n';",
+    "      charPos = 0;",
+    "   }",
+    "   *value = (unsigned char)charLine[charPos++];",
+    "   return 1;",
+    "}",
+    "",
+    "static void put_int(long long value)",
+    "{",
+    "   char buf[24];",
+    "   int n = snprintf(buf, sizeof(buf), \"%lld \", value);",
+    "   put_text(buf, n);",
+    "}",
+    "",
+    "/* MOD of the reference TM: a negative remainder gets |t| added. */",
+    "static long long mod(long long s, long long t)",
+    "{",
+    "   long long r = t == -1 ? 0 : s % t;",
+    "   if (r < 0)",
+    "      r += t < 0 ? -t : t;",
+    "   return r;",
+    "}",
+    "",
+    "static void reset(void)",
+    "{",
+    "   long long top = dSize - 1;",
+    "   int i;",
+    "   memset(dMem, 0, dSize * sizeof(long long));",
+    "   memset(reg, 0, sizeof(reg));",
+    "   reg[0] = top;",
+    "   reg[1] = top;",
+    "   dMem[0] = top;",
+    "   for (i = 0; i < LIT_COUNT; i++)",
+    "   {",
+    "      long long a = top - litOffset[i];",
+    "      long long len = strlen(litText[i]), k;",
+    "      if (a + 1 > top || a - len < 0)",
+    "         continue;",
+    "      dMem[a + 1] = len;",
+    "      for (k = 0; k < len; k++)",
+    "         dMem[a - k] = (unsigned char)litText[i][k];",
+    "   }",
+    "   status = TM_RUNNING;",
+    "   steps = 0;",
+    "   charLen = charPos = 0;",
+    "   srand(1);",
+    "}",
+    NULL};
+
+static const char *session[] = {
+    "",
+    "/* Command letters: u (echo input values), a N (abort limit), o N (no",
+    "   effect), g (go), l (reload), q or x (quit). */",
+    "int main(int argc, char *argv[])",
+    "{",
+    "   int stats = 0, i;",
+    "   size_t n;",
+    "   char *line;",
+    "   for (i = 1; i < argc; i++)",
+    "   {",
+    "      if (argv[i][0] == '-' && argv[i][1] == 'm' && atoll(argv[i] + 2) >= 2)",
+    "         dSize = atoll(argv[i] + 2);",
+    "      else if (strcmp(argv[i], \"-s\") == 0)",
+    "         stats = 1;",
+    "      else",
+    "      {",
+    "         printf(\"Usage: %s [-m<size>] [-s]\\n\", argv[0]);",
+    "         return 1;",
+    "      }",
+    "   }",
+    "   dMem = (long long *)malloc(dSize * sizeof(long long));",
+    "   input = (char *)malloc(65536);",
+    "   while ((n = fread(input + inputLen, 1, 65536, stdin)) > 0)",
+    "   {",
+    "      inputLen += n;",
+    "      input = (char *)realloc(input, inputLen + 65536);",
+    "   }",
+    "   reset();",
+    "",
+    "   put(\"Loading file: %s\\n\", TM_FILE);",
+    "   while ((line = read_line()) != NULL)",
+    "   {",
+    "      char *p = line + strspn(line, \" \\t\\r\");",
+    "      if (*p == '\\0')",
+    "         continue;",
+    "      switch (*p)",
+    "      {",
+    "      case 'u':",
+    "         echo = 1;",
+    "         break;",
+    "      case 'a':",
+    "         limit = atoll(p + 1);",
+    "         break;",
+    "      case 'o':",
+    "         break;",
+    "      case 'g':",
+    "         if (status != TM_RUNNING)",
+    "            reset();",
+    "         totalSteps -= steps;",
+    "         run();",
+    "         totalSteps += steps;",
+    "         if (status != TM_HALTED)",
+    "         {",
+    "            new_line();",
+    "            put(\"ERROR: %s after %lld instructions.\\n\", statusText[status], steps);",
+    "         }",
+    "         break;",
+    "      case 'l':",
+    "         reset();",
+    "         new_line();",
+    "         put(\"Loading file: %s\\n\", TM_FILE);",
+    "         break;",
+    "      case 'q':",
+    "      case 'x':",
+    "         inputPos = inputLen;",
+    "         break;",
+    "      default:",
+    "         new_line();",
+    "         put(\"ERROR: TM Command %c unknown.\\n\", *p);",
+    "         break;",
+    "      }",
+    "   }",
+    "   new_line();",
+    "   put(\"Bye.\\n\");",
+    "   flush_out();",
+    "   if (stats)",
+    "      fprintf(stderr, \"Instructions executed: %lld\\n\", totalSteps);",
+    "   return 0;",
+    "}",
+    NULL};
+
+/* ==================================================
+   TRANSLATION
+   ================================================== */
+static void write_lines(FILE *fptr, const char **lines)
+{
+   for (int i = 0; lines[i] != NULL; i++)
+      fprintf(fptr, "%s\n", lines[i]);
+}
+
+static string c_string(const string &text)
+{
+   string s = "\"";
+   for (size_t i = 0; i < text.size(); i++)
+   {
+      unsigned char c = text[i];
+      if (c == '"' || c == '\\' || c == '?')
+         s += string("\\") + (char)c;
+      else if (c < ' ' || c > '~')
+      {
+         char buf[8];
+         snprintf(buf, sizeof(buf), "\\%03o", c);
+         s += buf;
+      }
+      else
+         s += c;
+   }
+   return s + "\"";
+}
+
+// Register x as a C expression: r7 reads as the address after pc, in p7
+// when the instruction may write it.
+static string name(int x)
+{
+   return x == 7 ? "p7" : "r" + to_string(x);
+}
+
+// Jump to a TM address known now.
+static string go_to(long long target, int n)
+{
+   if (target >= 0 && target < n)
+      return "goto L" + to_string(target) + ";";
+   return "{ pc = " + to_string(target) + "; goto dispatch; }";
+}
+
+static const char *dispatch_pc = "{ pc = p7; goto dispatch; }";
+
+// The statement of one instruction, after its label and STEP.
+static string statement(TMInstr &in, int pc, int n)
+{
+   static const char *ops[] = {"+", "-", "*", "/", "%", "&", "|", "^"};
+   static const char *cmps[] = {"<", "<=", "==", "!=", ">=", ">"};
+   string r = name(in.r), s = name(in.s), t = name(in.t);
+   string d = to_string(in.s), at = to_string(pc);
+   string c;
+   switch (in.op)
+   {
+   case OP_HALT:
+      return "FAULT(" + at + ", TM_HALTED)";
+   case OP_NOP:
+      return "";
+   case OP_IN:
+   case OP_INB:
+   case OP_INC:
+      c = string("flush_out(); if (!") + (in.op == OP_IN ? "input_int" : in.op == OP_INB ? "input_bool" : "input_char") +
+          "(&v)) FAULT(" + at + ", TM_NO_INPUT) " + r + " = v;";
+      break;
+   case OP_OUT:
+      return "put_int(" + r + ");";
+   case OP_OUTB:
+      return "put_text(" + r + " ? \"T \" : \"F \", 2);";
+   case OP_OUTC:
+      return "{ char ch = (char)" + r + "; put_text(&ch, 1); }";
+   case OP_OUTNL:
+      return "put_text(\"\\n\", 1);";
+   case OP_ADD:
+   case OP_SUB:
+   case OP_MUL:
+   case OP_AND:
+   case OP_OR:
+   case OP_XOR:
+      c = r + " = " + s + " " + ops[in.op - OP_ADD] + " " + t + ";";
+      break;
+   case OP_DIV:
+   case OP_MOD:
+      c = "if (" + t + " == 0) FAULT(" + at + ", TM_ZERO_DIV) " + r + " = " +
+          (in.op == OP_DIV ? s + " / " + t : "mod(" + s + ", " + t + ")") + ";";
+      break;
+   case OP_NOT:
+      c = r + " = !" + s + ";";
+      break;
+   case OP_NEG:
+      c = r + " = -" + s + ";";
+      break;
+   case OP_SWP:
+      c = "if (" + r + " > " + s + ") { v = " + r + "; " + r + " = " + s + "; " + s + " = v; }";
+      break;
+   case OP_RND:
+      c = r + " = " + s + " > 0 ? rand() % " + s + " : 0;";
+      break;
+   case OP_TLT:
+   case OP_TLE:
+   case OP_TEQ:
+   case OP_TNE:
+   case OP_TGE:
+   case OP_TGT:
+      c = r + " = " + s + " " + cmps[in.op - OP_TLT] + " " + t + ";";
+      break;
+   case OP_SLT:
+      c = r + " = " + r + " > 0 ? " + s + " < " + t + " : " + s + " > " + t + ";";
+      break;
+   case OP_SGT:
+      c = r + " = " + s + " > " + t + ";";
+      break;
+   case OP_MOV:
+   case OP_SET:
+   case OP_CO:
+   case OP_COA:
+      c = "{ long long to = " + r + ", from = " + s + ", cnt = " + t + ", k = 0; " +
+          "if (cnt > 0 && (to - cnt + 1 < 0 || to >= dSize" +
+          (in.op == OP_SET ? "" : " || from - cnt + 1 < 0 || from >= dSize") + ")) FAULT(" + at + ", TM_DMEM_ERROR) ";
+      if (in.op == OP_MOV)
+         c += "for (; k < cnt; k++) dMem[to - k] = dMem[from - k]; }";
+      else if (in.op == OP_SET)
+         c += "for (; k < cnt; k++) dMem[to - k] = from; }";
+      else
+         c += "while (k < cnt && dMem[to - k] == dMem[from - k]) k++; " + r + " = k < cnt ? dMem[to - k] : 0; " + s +
+              " = k < cnt ? dMem[from - k] : 0; }";
+      break;
+   case OP_LDC:
+      if (in.r == 7)
+         return go_to(in.s, n);
+      c = r + " = " + d + ";";
+      break;
+   case OP_LDA:
+      if (in.r == 7 && in.t == 7)
+         return go_to(pc + 1 + in.s, n);
+      c = r + " = " + d + " + " + t + ";";
+      break;
+   case OP_LD:
+      c = "addr = " + d + " + " + t + "; CHECK(" + at + ") " + r + " = dMem[addr];";
+      break;
+   case OP_ST:
+      return "addr = " + d + " + " + t + "; CHECK(" + at + ") dMem[addr] = " + r + ";";
+   case OP_JMP:
+   case OP_JNZ:
+   case OP_JZR:
+   {
+      string jump = in.t == 7 ? go_to(pc + 1 + in.s, n) : "{ pc = " + d + " + " + t + "; goto dispatch; }";
+      if (in.op == OP_JMP)
+         return jump;
+      return "if (" + r + (in.op == OP_JNZ ? " != 0) " : " == 0) ") + jump;
+   }
+   }
+   // Everything that may write r7 jumps to where it points afterwards.
+   if (in.r == 7 || ((in.op == OP_SWP || in.op == OP_CO || in.op == OP_COA) && in.s == 7))
+      c += string(" ") + dispatch_pc;
+   return c;
+}
+
+// Writes "./tm -c" output: the runtime, then run() with one labelled
+// statement per instruction, then the session.
+bool tm_write_c(TMProgram &prog, const char *file)
+{
+   FILE *fptr = fopen(file, "w");
+   if (fptr == NULL)
+      return false;
+   int n = prog.iMem.size();
+   while (n > 1 && prog.iMem[n - 1].op == OP_HALT)
+      n--;
+
+   fprintf(fptr, "/* %s translated to C by ./tm -c; build with \"cc -O2\". */\n", prog.file.c_str());
+   fprintf(fptr, "#define TM_FILE %s\n", c_string(prog.file).c_str());
+   fprintf(fptr, "#define TM_DMEM_SIZE %d\n", TM_DMEM_SIZE);
+   fprintf(fptr, "#define TM_IMEM_SIZE %d\n", TM_IMEM_SIZE);
+   fprintf(fptr, "#define LIT_COUNT %d\n", (int)prog.lits.size());
+   fprintf(fptr, "static const long long litOffset[] = {");
+   for (size_t i = 0; i < prog.lits.size(); i++)
+      fprintf(fptr, "%d, ", prog.lits[i].first);
+   fprintf(fptr, "0};\nstatic const char *litText[] = {");
+   for (size_t i = 0; i < prog.lits.size(); i++)
+      fprintf(fptr, "%s, ", c_string(prog.lits[i].second).c_str());
+   fprintf(fptr, "\"\"};\n");
+   write_lines(fptr, runtime);
+
+   fprintf(fptr, "\nstatic void run(void)\n{\n");
+   fprintf(fptr, "   long long r0 = reg[0], r1 = reg[1], r2 = reg[2], r3 = reg[3], r4 = reg[4], r5 = reg[5], r6 = reg[6];\n");
+   fprintf(fptr, "   long long pc = reg[7], p7, addr, v;\n");
+   fprintf(fptr, "   long long count = steps, pause = limit != 0 ? limit : LLONG_MAX;\n");
+   fprintf(fptr, "   (void)p7, (void)addr, (void)v, (void)count, (void)pause, (void)input_int, (void)input_bool, (void)input_char, (void)mod;\n");
+   fprintf(fptr, "   status = TM_RUNNING;\n");
+   fprintf(fptr, "dispatch:\n   switch (pc)\n   {\n");
+   for (int i = 0; i < n; i++)
+      fprintf(fptr, "   case %d: goto L%d;\n", i, i);
+   fprintf(fptr, "   default:\n");
+   fprintf(fptr, "      if (pc < 0 || pc >= TM_IMEM_SIZE) { status = TM_IMEM_ERROR; goto stop; }\n");
+   fprintf(fptr, "      STEP(pc) FAULT(pc, TM_HALTED)\n");
+   fprintf(fptr, "   }\n");
+   for (int i = 0; i < n; i++)
+   {
+      TMInstr &in = prog.iMem[i];
+      bool r7 = in.r == 7 || in.t == 7 || (in.op < OP_LDC && in.s == 7);
+      fprintf(fptr, "L%d: /* %s %d,%d%s%d%s */ STEP(%d)%s %s\n", i, tm_opcode_name(in.op), in.r, in.s,
+              in.op < OP_LDC ? "," : "(", in.t, in.op < OP_LDC ? "" : ")", i,
+              r7 ? (" p7 = " + to_string(i + 1) + ";").c_str() : "", statement(in, i, n).c_str());
+   }
+   fprintf(fptr, "   pc = %d;\n   goto dispatch;\n", n);
+   fprintf(fptr, "stop:\n");
+   fprintf(fptr, "   steps = count;\n");
+   fprintf(fptr, "   if (status == TM_RUNNING && limit != 0 && steps >= limit)\n      status = TM_LIMIT;\n");
+   fprintf(fptr, "   reg[0] = r0, reg[1] = r1, reg[2] = r2, reg[3] = r3, reg[4] = r4, reg[5] = r5, reg[6] = r6;\n");
+   fprintf(fptr, "   reg[7] = pc;\n");
+   fprintf(fptr, "   flush_out();\n");
+   fprintf(fptr, "}\n");
+   write_lines(fptr, session);
+   return fclose(fptr) == 0;
+}
@@ -0,0 +1,20 @@
+#ifndef _TM_C_H
+#define _TM_C_H
+
+#include "tm.hpp"
+
+/* ==================================================
+   TM TO C TRANSLATOR
+   - Writes a loaded program as one C file: every TM instruction is a
+     labelled statement, jumps with a constant target are gotos and
+     computed jumps (returns, jump tables) go through a switch over the
+     TM addresses.
+   - The file carries the runtime of the VM (TM commands and input on
+     stdin, -m<size> and -s), so "cc -O2 prog.c" builds an executable
+     that behaves like "./tm prog.tm". With -DTM_FAST it does not count
+     instructions and ignores abort limits.
+   ================================================== */
+
+bool tm_write_c(TMProgram &prog, const char *file);
+
+#endif
@@ -0,0 +1,708 @@
+#include "tm_jit.hpp"
+#include <limits.h>
+#include <string.h>
+
+#if defined(__x86_64__) && defined(__linux__)
+#include <sys/mman.h>
+
+// Machine state handed to the native code, offsets are used by it.
+struct JitCtx
+{
+   long long *reg;  // 0: TM registers
+   long long *dMem; // 8: data memory
+   long long dSize; // 16
+   long long steps; // 24: instructions executed
+   long long pause; // 32: stop before steps would pass this
+};
+
+typedef void (*JitEntry)(JitCtx *ctx, const unsigned char *target);
+
+struct TMJit
+{
+   int size;                            // TM addresses translated
+   unsigned char *code;                 // mapped native code
+   size_t codeSize;
+   vector<const unsigned char *> table; // native entry of every TM address
+};
+
+/* ==================================================
+   X86-64 ENCODING
+   ================================================== */
+enum
+{
+   RAX, RCX, RDX, RBX, RSP, RBP, RSI, RDI,
+   R8, R9, R10, R11, R12, R13, R14, R15
+};
+
+// Condition codes of Jcc/SETcc/CMOVcc.
+enum
+{
+   CC_B = 0x2, CC_AE = 0x3, CC_E = 0x4, CC_NE = 0x5, CC_BE = 0x6, CC_A = 0x7,
+   CC_L = 0xC, CC_GE = 0xD, CC_LE = 0xE, CC_G = 0xF
+};
+
+// TM registers 0-6 live in r8-r14; r15 counts steps, rbx is the data
+// memory, rbp its size; rax, rcx, rdx, rsi and rdi are scratch.
+static int host(int tmReg)
+{
+   return R8 + tmReg;
+}
+
+struct Asm
+{
+   vector<unsigned char> code;
+   vector<int> labels;                 // label -> code offset (-1: not bound)
+   vector<pair<size_t, int> > fixups;  // rel32 offset, label
+
+   void b(int x) { code.push_back((unsigned char)x); }
+   void d32(long long x)
+   {
+      for (int k = 0; k < 4; k++)
+         b((int)(x >> (8 * k)) & 0xFF);
+   }
+   void q64(long long x)
+   {
+      for (int k = 0; k < 8; k++)
+         b((int)(x >> (8 * k)) & 0xFF);
+   }
+   int label()
+   {
+      labels.push_back(-1);
+      return labels.size() - 1;
+   }
+   void bind(int l) { labels[l] = code.size(); }
+   void rel32(int l)
+   {
+      fixups.push_back(make_pair(code.size(), l));
+      d32(0);
+   }
+   void resolve()
+   {
+      for (size_t i = 0; i < fixups.size(); i++)
+      {
+         long long rel = labels[fixups[i].second] - (long long)(fixups[i].first + 4);
+         for (int k = 0; k < 4; k++)
+            code[fixups[i].first + k] = (rel >> (8 * k)) & 0xFF;
+      }
+   }
+
+   void rex(int reg, int rm) { b(0x48 | ((reg >> 3) << 2) | (rm >> 3)); }
+   void modrm(int mod, int reg, int rm) { b((mod << 6) | ((reg & 7) << 3) | (rm & 7)); }
+   // op rm, reg (register operands)
+   void rr(int op, int reg, int rm)
+   {
+      rex(reg, rm);
+      b(op);
+      modrm(3, reg, rm);
+   }
+   // 0F op reg, rm
+   void rr2(int op, int reg, int rm)
+   {
+      rex(reg, rm);
+      b(0x0F);
+      b(op);
+      modrm(3, reg, rm);
+   }
+   void mov(int dst, int src)
+   {
+      if (dst != src)
+         rr(0x89, src, dst);
+   }
+   void mov_imm(int dst, long long v)
+   {
+      if (v >= INT_MIN && v <= INT_MAX)
+      {
+         rex(0, dst);
+         b(0xC7);
+         modrm(3, 0, dst);
+         d32(v);
+      }
+      else
+      {
+         rex(0, dst);
+         b(0xB8 + (dst & 7));
+         q64(v);
+      }
+   }
+   void lea(int dst, int base, long long disp)
+   {
+      rex(dst, base);
+      b(0x8D);
+      modrm(2, dst, base);
+      if ((base & 7) == RSP)
+         b(0x24);
+      d32(disp);
+   }
+   // op reg, [base + disp8] (base is not rsp/r12)
+   void mem8(int op, int reg, int base, int disp)
+   {
+      rex(reg, base);
+      b(op);
+      modrm(1, reg, base);
+      b(disp);
+   }
+   // op reg, [rbx + rax*8]
+   void data(int op, int reg)
+   {
+      rex(reg, RAX);
+      b(op);
+      modrm(0, reg, 4);
+      b(0xC3);
+   }
+   void load_stack(int reg, int disp)
+   {
+      rex(reg, RSP);
+      b(0x8B);
+      modrm(1, reg, 4);
+      b(0x24);
+      b(disp);
+   }
+   void setcc(int cc, int reg)
+   {
+      b(0x0F);
+      b(0x90 + cc);
+      modrm(3, 0, reg);
+      b(0x0F);
+      b(0xB6);
+      modrm(3, reg, reg); // movzx e<reg>, <reg>l
+   }
+   void jcc(int cc, int l)
+   {
+      b(0x0F);
+      b(0x80 + cc);
+      rel32(l);
+   }
+   void jmp(int l)
+   {
+      b(0xE9);
+      rel32(l);
+   }
+   void push(int r)
+   {
+      if (r >= R8)
+         b(0x41);
+      b(0x50 + (r & 7));
+   }
+   void pop(int r)
+   {
+      if (r >= R8)
+         b(0x41);
+      b(0x58 + (r & 7));
+   }
+   // add/sub r15, imm32 (ext 0: add, 5: sub)
+   void steps(int ext, int n)
+   {
+      b(0x49);
+      b(0x81);
+      modrm(3, ext, R15);
+      d32(n);
+   }
+};
+
+/* ==================================================
+   TRANSLATION
+   ================================================== */
+// Instructions left to the interpreter.
+static bool interpreted(TMInstr &in)
+{
+   switch (in.op)
+   {
+   case OP_HALT:
+   case OP_IN:
+   case OP_INB:
+   case OP_INC:
+   case OP_OUT:
+   case OP_OUTB:
+   case OP_OUTC:
+   case OP_OUTNL:
+   case OP_RND:
+   case OP_MOV:
+   case OP_SET:
+   case OP_CO:
+   case OP_COA:
+      return true;
+   case OP_SWP:
+      return in.r == 7 || in.s == 7;
+   }
+   return false;
+}
+
+static bool writes_pc(TMInstr &in)
+{
+   switch (in.op)
+   {
+   case OP_NOP:
+   case OP_ST:
+      return false;
+   case OP_JMP:
+   case OP_JNZ:
+   case OP_JZR:
+      return true;
+   }
+   return in.r == 7;
+}
+
+// Target of a jump whose target does not depend on a register, or -1.
+static long long static_target(TMInstr &in, int pc)
+{
+   if (in.op == OP_LDC && in.r == 7)
+      return in.s;
+   if ((in.op == OP_JMP || in.op == OP_JNZ || in.op == OP_JZR || (in.op == OP_LDA && in.r == 7)) && in.t == 7)
+      return pc + 1 + in.s;
+   return -1;
+}
+
+struct Translator
+{
+   Asm a;
+   vector<TMInstr> &iMem;
+   int n;
+   vector<int> entry;    // label checking the block budget before address i
+   vector<int> body;     // label of the code of address i
+   vector<int> blockEnd; // first address after the block of i
+   int exitLabel, dispatchLabel;
+   struct Stub
+   {
+      int label, pc, adjust;
+   };
+   vector<Stub> stubs;
+
+   Translator(vector<TMInstr> &mem, int size) : iMem(mem), n(size) {}
+
+   // Leaves native code before pc runs; steps counted for the rest of its
+   // block are taken back.
+   int exit_stub(int pc, int adjust)
+   {
+      Stub s = {a.label(), pc, adjust};
+      stubs.push_back(s);
+      return s.label;
+   }
+
+   void jump_to(long long target)
+   {
+      if (target >= 0 && target < n)
+         a.jmp(entry[target]);
+      else
+      {
+         a.mov_imm(RAX, target);
+         a.jmp(exitLabel);
+      }
+   }
+
+   // rax <- TM register x (r7 reads as the address after pc)
+   void load(int dst, int x, int pc)
+   {
+      if (x == 7)
+         a.mov_imm(dst, pc + 1);
+      else
+         a.mov(dst, host(x));
+   }
+
+   int operand(int x, int scratch, int pc)
+   {
+      if (x != 7)
+         return host(x);
+      a.mov_imm(scratch, pc + 1);
+      return scratch;
+   }
+
+   // TM register r <- rax; r7 is a computed jump.
+   void store(int r)
+   {
+      if (r == 7)
+         a.jmp(dispatchLabel);
+      else
+         a.mov(host(r), RAX);
+   }
+
+   // rax <- d + reg t, checked against the data memory size.
+   void address(TMInstr &in, int pc)
+   {
+      if (in.t == 7)
+         a.mov_imm(RAX, pc + 1 + in.s);
+      else
+         a.lea(RAX, host(in.t), in.s);
+      a.rr(0x39, RBP, RAX); // cmp rax, rbp
+      a.jcc(CC_AE, exit_stub(pc, blockEnd[pc] - pc));
+   }
+
+   // Charges the rest of the block to r15 unless that passes the pause.
+   void budget(int pc)
+   {
+      a.lea(RAX, R15, blockEnd[pc] - pc);
+      a.rex(RAX, RSP);
+      a.b(0x3B); // cmp rax, [rsp+8]
+      a.modrm(1, RAX, 4);
+      a.b(0x24);
+      a.b(8);
+      a.jcc(CC_A, exit_stub(pc, 0));
+      a.mov(R15, RAX);
+   }
+
+   void instruction(TMInstr &in, int pc)
+   {
+      static const int cmpCC[] = {CC_L, CC_LE, CC_E, CC_NE, CC_GE, CC_G};
+      int x;
+      switch (in.op)
+      {
+      case OP_NOP:
+         break;
+      case OP_ADD:
+      case OP_SUB:
+      case OP_AND:
+      case OP_OR:
+      case OP_XOR:
+      case OP_MUL:
+         load(RAX, in.s, pc);
+         x = operand(in.t, RCX, pc);
+         if (in.op == OP_MUL)
+            a.rr2(0xAF, RAX, x);
+         else
+            a.rr(in.op == OP_ADD ? 0x01 : in.op == OP_SUB ? 0x29 : in.op == OP_AND ? 0x21 : in.op == OP_OR ? 0x09 : 0x31,
+                 x, RAX);
+         store(in.r);
+         break;
+      case OP_DIV:
+      case OP_MOD:
+         x = operand(in.t, RCX, pc);
+         a.rr(0x85, x, x); // test
+         a.jcc(CC_E, exit_stub(pc, blockEnd[pc] - pc));
+         load(RAX, in.s, pc);
+         a.b(0x48); // cqo
+         a.b(0x99);
+         a.rex(0, x); // idiv
+         a.b(0xF7);
+         a.modrm(3, 7, x);
+         if (in.op == OP_MOD)
+         {
+            // As the interpreter: a negative remainder gets |t| added.
+            a.mov(RAX, x);
+            a.rex(0, RAX); // neg
+            a.b(0xF7);
+            a.modrm(3, 3, RAX);
+            a.rr2(0x40 + CC_L, RAX, x);   // cmovl: rax <- |t|
+            a.rr(0x01, RDX, RAX);         // add
+            a.rr(0x85, RDX, RDX);         // test
+            a.rr2(0x40 + CC_GE, RAX, RDX); // cmovge: rax <- rdx if not negative
+         }
+         store(in.r);
+         break;
+      case OP_NOT:
+         load(RAX, in.s, pc);
+         a.rr(0x85, RAX, RAX);
+         a.setcc(CC_E, RAX);
+         store(in.r);
+         break;
+      case OP_NEG:
+         load(RAX, in.s, pc);
+         a.rex(0, RAX); // neg
+         a.b(0xF7);
+         a.modrm(3, 3, RAX);
+         store(in.r);
+         break;
+      case OP_TLT:
+      case OP_TLE:
+      case OP_TEQ:
+      case OP_TNE:
+      case OP_TGE:
+      case OP_TGT:
+      case OP_SGT:
+         load(RAX, in.s, pc);
+         x = operand(in.t, RCX, pc);
+         a.rr(0x39, x, RAX); // cmp rax, x
+         a.setcc(in.op == OP_SGT ? CC_G : cmpCC[in.op - OP_TLT], RAX);
+         store(in.r);
+         break;
+      case OP_SLT: // r > 0 ? s < t : s > t
+         load(RAX, in.s, pc);
+         x = operand(in.t, RCX, pc);
+         a.rr(0x39, x, RAX);
+         a.setcc(CC_L, RAX);
+         a.setcc(CC_G, RCX);
+         x = operand(in.r, RDX, pc);
+         a.rr(0x85, x, x);
+         a.rr2(0x40 + CC_LE, RAX, RCX); // cmovle rax, rcx
+         store(in.r);
+         break;
+      case OP_SWP: // r <- min(r,s), s <- max(r,s)
+         if (in.r == in.s)
+            break;
+         a.mov(RAX, host(in.r));
+         a.rr(0x39, host(in.s), RAX);
+         a.rr2(0x40 + CC_G, host(in.r), host(in.s));
+         a.rr2(0x40 + CC_G, host(in.s), RAX);
+         break;
+      case OP_LDC:
+         if (in.r == 7)
+            jump_to(in.s);
+         else
+            a.mov_imm(host(in.r), in.s);
+         break;
+      case OP_LDA:
+         if (in.r == 7 && in.t == 7)
+            jump_to(pc + 1 + in.s);
+         else if (in.t == 7)
+            a.mov_imm(host(in.r), pc + 1 + in.s);
+         else if (in.r == 7)
+         {
+            a.lea(RAX, host(in.t), in.s);
+            a.jmp(dispatchLabel);
+         }
+         else
+            a.lea(host(in.r), host(in.t), in.s);
+         break;
+      case OP_LD:
+         address(in, pc);
+         if (in.r == 7)
+         {
+            a.data(0x8B, RAX);
+            a.jmp(dispatchLabel);
+         }
+         else
+            a.data(0x8B, host(in.r));
+         break;
+      case OP_ST:
+         address(in, pc);
+         a.data(0x89, operand(in.r, RCX, pc));
+         break;
+      case OP_JMP:
+         if (in.t == 7)
+            jump_to(pc + 1 + in.s);
+         else
+         {
+            a.lea(RAX, host(in.t), in.s);
+            a.jmp(dispatchLabel);
+         }
+         break;
+      case OP_JNZ:
+      case OP_JZR:
+      {
+         // r7 is never zero: JNZ on it always jumps, JZR never does.
+         if (in.r == 7)
+         {
+            if (in.op == OP_JNZ)
+            {
+               TMInstr jmp = {OP_JMP, 0, in.s, in.t};
+               instruction(jmp, pc);
+            }
+            break;
+         }
+         a.rr(0x85, host(in.r), host(in.r));
+         int cc = in.op == OP_JNZ ? CC_NE : CC_E;
+         long long target = static_target(in, pc);
+         if (target >= 0 && target < n)
+            a.jcc(cc, entry[target]);
+         else
+         {
+            int skip = a.label();
+            a.jcc(cc ^ 1, skip);
+            if (in.t == 7)
+               jump_to(target);
+            else
+            {
+               a.lea(RAX, host(in.t), in.s);
+               a.jmp(dispatchLabel);
+            }
+            a.bind(skip);
+         }
+         break;
+      }
+      }
+   }
+
+   void translate(const unsigned char *const *table)
+   {
+      // Blocks start at 0, at constant jump targets and after anything
+      // that jumps or leaves native code.
+      vector<bool> leader(n + 1, false);
+      leader[0] = true;
+      for (int i = 0; i < n; i++)
+      {
+         long long target = static_target(iMem[i], i);
+         if (target >= 0 && target < n)
+            leader[target] = true;
+         if (writes_pc(iMem[i]) || interpreted(iMem[i]))
+            leader[i + 1] = true;
+      }
+      blockEnd.assign(n, n);
+      for (int i = n - 1; i >= 0; i--)
+         blockEnd[i] = leader[i + 1] || i + 1 == n ? i + 1 : blockEnd[i + 1];
+      for (int i = 0; i < n; i++)
+      {
+         entry.push_back(a.label());
+         body.push_back(a.label());
+      }
+      exitLabel = a.label();
+      dispatchLabel = a.label();
+
+      // Entry: jit(ctx, target) saves the callee-saved registers, keeps ctx
+      // and the pause on the stack and loads the machine state.
+      static const int saved[] = {RBX, RBP, R12, R13, R14, R15};
+      for (int k = 0; k < 6; k++)
+         a.push(saved[k]);
+      a.b(0xFF); // push qword [rdi+32]
+      a.modrm(1, 6, RDI);
+      a.b(32);
+      a.push(RDI);
+      a.mem8(0x8B, RBX, RDI, 8);
+      a.mem8(0x8B, RBP, RDI, 16);
+      a.mem8(0x8B, R15, RDI, 24);
+      a.mem8(0x8B, RAX, RDI, 0);
+      for (int r = 0; r < 7; r++)
+         a.mem8(0x8B, host(r), RAX, 8 * r);
+      a.b(0xFF); // jmp rsi
+      a.modrm(3, 4, RSI);
+
+      for (int i = 0; i < n; i++)
+      {
+         if (leader[i])
+         {
+            a.bind(entry[i]);
+            budget(i);
+         }
+         a.bind(body[i]);
+         if (interpreted(iMem[i]))
+         {
+            a.steps(5, blockEnd[i] - i);
+            a.mov_imm(RAX, i);
+            a.jmp(exitLabel);
+         }
+         else
+            instruction(iMem[i], i);
+      }
+      a.mov_imm(RAX, n);
+      a.jmp(exitLabel);
+
+      // Entries into the middle of a block (computed jump targets).
+      for (int i = 0; i < n; i++)
+      {
+         if (leader[i])
+            continue;
+         a.bind(entry[i]);
+         budget(i);
+         a.jmp(body[i]);
+      }
+
+      // Dispatch: rax is the TM address jumped to.
+      a.bind(dispatchLabel);
+      a.b(0x48); // cmp rax, n
+      a.b(0x3D);
+      a.d32(n);
+      a.jcc(CC_AE, exitLabel);
+      a.mov_imm(RCX, (long long)table);
+      a.b(0xFF); // jmp [rcx+rax*8]
+      a.modrm(0, 4, 4);
+      a.b(0xC1);
+
+      for (size_t k = 0; k < stubs.size(); k++)
+      {
+         a.bind(stubs[k].label);
+         if (stubs[k].adjust != 0)
+            a.steps(5, stubs[k].adjust);
+         a.mov_imm(RAX, stubs[k].pc);
+         a.jmp(exitLabel);
+      }
+
+      // Exit: rax is the TM address to go on at; the machine state is
+      // written back.
+      a.bind(exitLabel);
+      a.load_stack(RDI, 0);
+      a.mem8(0x8B, RSI, RDI, 0);
+      for (int r = 0; r < 7; r++)
+         a.mem8(0x89, host(r), RSI, 8 * r);
+      a.mem8(0x89, RAX, RSI, 56);
+      a.mem8(0x89, R15, RDI, 24);
+      a.b(0x48); // add rsp, 16
+      a.b(0x83);
+      a.modrm(3, 0, RSP);
+      a.b(16);
+      for (int k = 5; k >= 0; k--)
+         a.pop(saved[k]);
+      a.b(0xC3);
+      a.resolve();
+   }
+};
+
+/* ==================================================
+   INTERFACE
+   ================================================== */
+TMJit *tm_jit_compile(TMProgram &prog)
+{
+   int n = prog.iMem.size();
+   while (n > 1 && prog.iMem[n - 1].op == OP_HALT)
+      n--;
+   TMJit *jit = new TMJit;
+   jit->size = n;
+   jit->table.assign(n, NULL);
+
+   Translator tr(prog.iMem, n);
+   tr.translate(jit->table.data());
+   jit->codeSize = tr.a.code.size();
+   void *mem = mmap(NULL, jit->codeSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+   if (mem == MAP_FAILED)
+   {
+      delete jit;
+      return NULL;
+   }
+   jit->code = (unsigned char *)mem;
+   memcpy(jit->code, tr.a.code.data(), jit->codeSize);
+   if (mprotect(mem, jit->codeSize, PROT_READ | PROT_EXEC) != 0)
+   {
+      munmap(mem, jit->codeSize);
+      delete jit;
+      return NULL;
+   }
+   for (int i = 0; i < n; i++)
+      jit->table[i] = jit->code + tr.a.labels[tr.entry[i]];
+   return jit;
+}
+
+void tm_jit_free(TMJit *jit)
+{
+   if (jit == NULL)
+      return;
+   munmap(jit->code, jit->codeSize);
+   delete jit;
+}
+
+// Native code runs from the PC until it reaches an instruction it leaves
+// to the interpreter, which runs that one and hands back.
+void tm_jit_run(TMJit *jit, TMMachine &m)
+{
+   JitCtx ctx;
+   ctx.reg = m.reg;
+   ctx.dMem = m.dMem.data();
+   ctx.dSize = m.dMem.size();
+   ctx.pause = m.limit != TM_NO_LIMIT ? m.limit : LLONG_MAX;
+   JitEntry enter = (JitEntry)jit->code;
+   while (m.status == TM_RUNNING)
+   {
+      long long pc = m.reg[7];
+      if (pc >= 0 && pc < jit->size)
+      {
+         ctx.steps = m.steps;
+         enter(&ctx, jit->table[pc]);
+         m.steps = ctx.steps;
+      }
+      tm_step(m);
+   }
+}
+
+#else
+
+TMJit *tm_jit_compile(TMProgram &prog)
+{
+   return NULL;
+}
+
+void tm_jit_free(TMJit *jit)
+{
+}
+
+void tm_jit_run(TMJit *jit, TMMachine &m)
+{
+   while (m.status == TM_RUNNING)
+      tm_step(m);
+}
+
+#endif
@@ -0,0 +1,26 @@
+#ifndef _TM_JIT_H
+#define _TM_JIT_H
+
+#include "tm.hpp"
+
+/* ==================================================
+   TM JIT (x86-64)
+   - Translates the instruction memory of a loaded program to native code
+     once: TM registers 0-6 live in host registers, LD/ST index the data
+     memory array, jumps with a constant target become native branches and
+     computed jumps (JMP 0(3), ADD 7,...) go through a table of the native
+     address of every TM address.
+   - I/O, RND, HALT, MOV/SET/CO/COA and instructions that fault (data
+     memory out of range, division by zero) return to the interpreter,
+     which runs that one instruction before native code resumes.
+   - Steps are counted per block, and a block that would cross the abort
+     limit is left to the interpreter, so counts and limits are exact.
+   ================================================== */
+
+struct TMJit;
+
+TMJit *tm_jit_compile(TMProgram &prog);
+void tm_jit_free(TMJit *jit);
+void tm_jit_run(TMJit *jit, TMMachine &m);
+
+#endif
@@ -0,0 +1,183 @@
+#include "tm.hpp"
+#include "tm_jit.hpp"
+#include "tm_c.hpp"
+#include <stdlib.h>
+#include <string.h>
+
+/* ==================================================
+   main() function for the TM virtual machine!
+   - ./tm [options] <file.tm>, commands and input on stdin.
+   ================================================== */
+static void usage()
+{
+   printf("Usage: ./tm [-m<size>] [-b<size>] [-j] [-s] [-p <profile>] [-r <report>] [-g <calls>] [-v <coverage>]\n"
+          "            [-k <checkpoint> [-i<steps>]] [-l <checkpoint>] [-c <file.c>] <file.tm>\n");
+   printf("   -m<size>     data memory size (default %d)\n", TM_DMEM_SIZE);
+   printf("   -b<size>     output buffer size in bytes, 0 writes every value (default %d)\n", TM_OUT_BUFFER);
+   printf("   -j           translate the program to native code before running it\n");
+   printf("   -s           print the number of instructions executed to stderr\n");
+   printf("   -p <profile> write execution counts of the -fprofile-gen sites\n");
+   printf("   -r <report>  write instruction counts per opcode, function, line and address\n");
+   printf("                to <report> and <report>.json\n");
+   printf("   -g <calls>   write calls and inclusive/exclusive instruction counts per function\n");
+   printf("                to <calls> and the call stacks in folded form to <calls>.folded\n");
+   printf("   -v <coverage> write the C- source with line executions and branches taken\n");
+   printf("                (programs compiled with -fcoverage)\n");
+   printf("   -k <file>    write the state of the run to <file> every -i<steps> instructions\n");
+   printf("                (default %d)\n", TM_CHECKPOINT_STEPS);
+   printf("   -l <file>    resume the run saved in checkpoint <file> (same program and input)\n");
+   printf("   -c <file.c>  write the program as a C program instead of running it\n");
+   exit(1);
+}
+
+int main(int argc, char *argv[])
+{
+   long long dmemSize = TM_DMEM_SIZE;
+   int outBufSize = TM_OUT_BUFFER;
+   bool stats = false;
+   bool jit = false;
+   char *profile = NULL;
+   char *report = NULL;
+   char *callGraph = NULL;
+   char *coverage = NULL;
+   char *checkpoint = NULL;
+   long long checkpointSteps = TM_CHECKPOINT_STEPS;
+   char *resume = NULL;
+   char *cFile = NULL;
+
+   if (argc < 2)
+      usage();
+   for (int i = 1; i < argc - 1; i++)
+   {
+      if (argv[i][0] != '-')
+         usage();
+      switch (argv[i][1])
+      {
+      case 'm':
+         dmemSize = atoll(&argv[i][2]);
+         if (dmemSize < 2)
+            usage();
+         break;
+      case 'b':
+         outBufSize = atoi(&argv[i][2]);
+         if (outBufSize < 0)
+            usage();
+         break;
+      case 'j':
+         jit = true;
+         break;
+      case 's':
+         stats = true;
+         break;
+      case 'p':
+         if (i + 1 >= argc - 1)
+            usage();
+         profile = argv[++i];
+         break;
+      case 'r':
+         if (i + 1 >= argc - 1)
+            usage();
+         report = argv[++i];
+         break;
+      case 'g':
+         if (i + 1 >= argc - 1)
+            usage();
+         callGraph = argv[++i];
+         break;
+      case 'v':
+         if (i + 1 >= argc - 1)
+            usage();
+         coverage = argv[++i];
+         break;
+      case 'k':
+         if (i + 1 >= argc - 1)
+            usage();
+         checkpoint = argv[++i];
+         break;
+      case 'i':
+         checkpointSteps = atoll(&argv[i][2]);
+         if (checkpointSteps < 1)
+            usage();
+         break;
+      case 'l':
+         if (i + 1 >= argc - 1)
+            usage();
+         resume = argv[++i];
+         break;
+      case 'c':
+         if (i + 1 >= argc - 1)
+            usage();
+         cFile = argv[++i];
+         break;
+      default:
+         usage();
+      }
+   }
+
+   TMProgram prog;
+   if (!tm_load(prog, argv[argc - 1]))
+      exit(1);
+   if (cFile != NULL)
+   {
+      if (!tm_write_c(prog, cFile))
+      {
+         printf("ERROR: \"%s\" could not be written.\n", cFile);
+         exit(1);
+      }
+      return 0;
+   }
+   if (profile != NULL && prog.sites.empty())
+      printf("WARNING: \"%s\" has no profile sites (compile it with -fprofile-gen).\n", argv[argc - 1]);
+   if (coverage != NULL && prog.probes.empty())
+      printf("WARNING: \"%s\" has no coverage probes (compile it with -fcoverage).\n", argv[argc - 1]);
+
+   TMMachine m;
+   tm_init(m, &prog, dmemSize);
+   m.outBufSize = outBufSize;
+   if (jit)
+   {
+      m.jit = tm_jit_compile(prog);
+      if (m.jit == NULL)
+         printf("WARNING: no native code for this host, \"%s\" is interpreted.\n", argv[argc - 1]);
+   }
+   char buf[4096];
+   size_t n;
+   while ((n = fread(buf, 1, sizeof(buf), stdin)) > 0)
+      m.input.append(buf, n);
+   if (profile != NULL || report != NULL || coverage != NULL)
+      m.hits.assign(TM_IMEM_SIZE, 0);
+   if (callGraph != NULL)
+      m.calls = tm_call_graph_new(prog);
+   m.checkpoint = checkpoint;
+   m.checkpointSteps = checkpointSteps;
+   if (resume != NULL && !tm_read_checkpoint(m, resume))
+      exit(1);
+
+   tm_session(m);
+
+   tm_jit_free(m.jit);
+   if (stats)
+      fprintf(stderr, "Instructions executed: %lld\n", m.totalSteps);
+   if (profile != NULL && !tm_write_profile(m, profile))
+   {
+      printf("ERROR: profile \"%s\" could not be written.\n", profile);
+      exit(1);
+   }
+   if (report != NULL && !tm_write_report(m, report))
+   {
+      printf("ERROR: report \"%s\" could not be written.\n", report);
+      exit(1);
+   }
+   if (callGraph != NULL && !tm_write_call_graph(m, callGraph))
+   {
+      printf("ERROR: call graph \"%s\" could not be written.\n", callGraph);
+      exit(1);
+   }
+   if (coverage != NULL && !tm_write_coverage(m, coverage))
+   {
+      printf("ERROR: coverage \"%s\" could not be written.\n", coverage);
+      exit(1);
+   }
+   tm_call_graph_free(m.calls);
+   return 0;
+}